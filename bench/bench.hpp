@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BENCH_BENCH_HPP
+#define BOOST_HTTP_PROTO_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/*  A minimal benchmark runner.
+
+    Each case is a function which processes one
+    batch of messages. The runner repeats it,
+    doubling the count until a batch lasts long
+    enough to time, then reports the rate over
+    the best of several runs.
+
+    Pass a substring on the command line to run
+    only the cases whose names contain it.
+*/
+struct case_
+{
+    std::string name;
+    std::size_t bytes;      // per call
+    std::size_t messages;   // per call
+    std::function<void()> fn;
+};
+
+inline
+std::vector<case_>&
+cases()
+{
+    static std::vector<case_> v;
+    return v;
+}
+
+inline
+void
+add(
+    std::string name,
+    std::size_t bytes,
+    std::size_t messages,
+    std::function<void()> fn)
+{
+    cases().push_back({
+        std::move(name),
+        bytes,
+        messages,
+        std::move(fn) });
+}
+
+// prevents the optimizer from
+// discarding a computed value
+template<class T>
+inline
+void
+do_not_optimize(T const& t)
+{
+    static volatile char sink;
+    sink = *reinterpret_cast<
+        char const volatile*>(&t);
+    (void)sink;
+}
+
+inline
+double
+seconds(std::size_t n, case_ const& c)
+{
+    auto const t0 =
+        std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < n; ++i)
+        c.fn();
+    auto const t1 =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<
+        double>(t1 - t0).count();
+}
+
+inline
+int
+run(int argc, char** argv)
+{
+    char const* filter =
+        argc > 1 ? argv[1] : "";
+    std::printf("%-48s %12s %14s %12s\n",
+        "case", "ns/msg", "msgs/s", "MB/s");
+    for(auto const& c : cases())
+    {
+        if(c.name.find(filter) ==
+                std::string::npos)
+            continue;
+
+        // calibrate
+        std::size_t n = 1;
+        while(seconds(n, c) < 0.05)
+            n *= 2;
+
+        double best = 1e300;
+        for(int i = 0; i < 5; ++i)
+        {
+            auto const t = seconds(n, c);
+            if( best > t)
+                best = t;
+        }
+        auto const calls =
+            static_cast<double>(n);
+        auto const msgs = calls *
+            static_cast<double>(c.messages);
+        auto const bytes = calls *
+            static_cast<double>(c.bytes);
+        std::printf(
+            "%-48s %12.1f %14.0f %12.1f\n",
+            c.name.c_str(),
+            best * 1e9 / msgs,
+            msgs / best,
+            bytes / best / 1e6);
+    }
+    return 0;
+}
+
+} // bench
+
+#endif
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures string_to_field, which the parser
+// calls once for every field line it reads,
+// against the table it replaced.
+
+#include <boost/http_proto/field.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace http_proto = boost::http_proto;
+
+namespace {
+
+// Names seen in typical browser and
+// proxy traffic, in mixed case
+char const* const common_names[] = {
+    "Host",
+    "User-Agent",
+    "Accept",
+    "Accept-Language",
+    "Accept-Encoding",
+    "Connection",
+    "Referer",
+    "Cookie",
+    "Upgrade-Insecure-Requests",
+    "Cache-Control",
+    "content-type",
+    "content-length",
+    "If-None-Match",
+    "If-Modified-Since",
+    "Authorization",
+    "date",
+    "server",
+    "etag",
+    "vary",
+    "Transfer-Encoding"
+    };
+
+// Names which are not in the table
+char const* const unknown_names[] = {
+    "X-Forwarded-For",
+    "X-Request-Id",
+    "Sec-Ch-Ua-Mobile",
+    "Sec-Ch-Ua-Platform",
+    "Sec-Ch-Ua",
+    "X-Amzn-Trace-Id",
+    "CF-Ray",
+    "X-Custom"
+    };
+
+/*  The previous lookup, as a baseline.
+
+    A multiply-add digest over every character
+    selects one of 5155 rows, each holding up
+    to two candidates which are compared in
+    turn.
+*/
+class baseline_table
+{
+public:
+    baseline_table()
+    {
+        auto const n = static_cast<std::size_t>(
+            http_proto::field::xref) + 1;
+        by_name_.resize(n);
+        for(std::size_t i = 1; i < n; ++i)
+        {
+            by_name_[i] = http_proto::to_string(
+                static_cast<http_proto::field>(i));
+            auto const j = digest(by_name_[i]) % N;
+            if(i < 256)
+                map_[j][0] = static_cast<
+                    unsigned char>(i);
+            else
+                map_[j][1] = static_cast<
+                    unsigned char>(i - 255);
+        }
+    }
+
+    http_proto::field
+    string_to_field(
+        boost::core::string_view s) const noexcept
+    {
+        auto const j = digest(s) % N;
+        int i = map_[j][0];
+        if(i != 0 && equals(s, by_name_[i]))
+            return static_cast<http_proto::field>(i);
+        i = map_[j][1];
+        if(i == 0)
+            return http_proto::field::unknown;
+        i += 255;
+        if(equals(s, by_name_[i]))
+            return static_cast<http_proto::field>(i);
+        return http_proto::field::unknown;
+    }
+
+private:
+    enum { N = 5155 };
+
+    static
+    std::uint32_t
+    get_chars(
+        unsigned char const* p) noexcept
+    {
+        return
+             p[0] |
+            (p[1] <<  8) |
+            (p[2] << 16) |
+            (p[3] << 24);
+    }
+
+    static
+    std::uint32_t
+    digest(boost::core::string_view s) noexcept
+    {
+        std::uint32_t r = 0;
+        std::size_t n = s.size();
+        auto p = reinterpret_cast<
+            unsigned char const*>(s.data());
+        while(n >= 4)
+        {
+            auto const v = get_chars(p);
+            r = (r * 5 + (
+                v | 0x20202020 ));
+            p += 4;
+            n -= 4;
+        }
+        while( n > 0 )
+        {
+            r = r * 5 + ( *p | 0x20 );
+            ++p;
+            --n;
+        }
+        return r;
+    }
+
+    static
+    bool
+    equals(
+        boost::core::string_view lhs,
+        boost::core::string_view rhs) noexcept
+    {
+        auto n = lhs.size();
+        if(n != rhs.size())
+            return false;
+        auto p1 = reinterpret_cast<
+            unsigned char const*>(lhs.data());
+        auto p2 = reinterpret_cast<
+            unsigned char const*>(rhs.data());
+        for(; n >= 4; p1 += 4, p2 += 4, n -= 4)
+            if((get_chars(p1) ^ get_chars(p2)) &
+                    0xDFDFDFDF)
+                return false;
+        for(; n; ++p1, ++p2, --n)
+            if(( *p1 ^ *p2) & 0xDF)
+                return false;
+        return true;
+    }
+
+    std::vector<boost::core::string_view> by_name_;
+    unsigned char map_[ N ][ 2 ] = {};
+};
+
+template<
+    std::size_t N,
+    class Lookup>
+void
+run(
+    char const* title,
+    char const* const (&names)[N],
+    Lookup const& lookup)
+{
+    std::size_t const rounds = 2000000;
+    std::vector<std::string> v(
+        names, names + N);
+    unsigned sum = 0;
+    auto const t0 =
+        std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < rounds; ++i)
+        for(auto const& s : v)
+            sum += static_cast<unsigned>(
+                lookup(s));
+    auto const t1 =
+        std::chrono::steady_clock::now();
+    auto const ns = std::chrono::duration<
+        double, std::nano>(t1 - t0).count();
+    std::cout <<
+        title << ": " <<
+        ns / (double(rounds) * N) << " ns/lookup" <<
+        " (" << sum << ")\n";
+}
+
+} // (anon)
+
+int
+main()
+{
+    auto const current =
+        [](std::string const& s)
+        {
+            return http_proto::string_to_field(s);
+        };
+    baseline_table const tab;
+    auto const baseline =
+        [&tab](std::string const& s)
+        {
+            return tab.string_to_field(s);
+        };
+    run("known fields", common_names, current);
+    run("known fields (baseline)", common_names, baseline);
+    run("unknown fields", unknown_names, current);
+    run("unknown fields (baseline)", unknown_names, baseline);
+    return 0;
+}
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures building responses, with storage
+// from the global heap, from an arena
+// released once per batch, and inline, and
+// with the fields appended one at a time
+// or at once.
+
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/static_response.hpp>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <cstddef>
+#include <string>
+
+#include "bench.hpp"
+
+namespace http_proto = boost::http_proto;
+namespace pmr = boost::container::pmr;
+
+namespace {
+
+// responses built per batch, as
+// by a pipelined connection
+constexpr std::size_t batch = 16;
+
+std::size_t
+build(http_proto::response_base& res)
+{
+    res.set_start_line(
+        http_proto::status::ok);
+    res.set(http_proto::field::server, "boost");
+    res.set(http_proto::field::date,
+        "Sun, 06 Nov 1994 08:49:37 GMT");
+    res.set(http_proto::field::content_type,
+        "text/html; charset=utf-8");
+    res.set(http_proto::field::cache_control,
+        "no-cache, no-store, must-revalidate");
+    res.set(http_proto::field::vary,
+        "Accept-Encoding");
+    res.set(http_proto::field::etag,
+        "\"33a64df551425fcc55e4d42a148795d9f25f89d4\"");
+    res.set_content_length(4096);
+    res.set_keep_alive(true);
+    return res.buffer().size();
+}
+
+// the same response, with one append
+std::size_t
+build_list(http_proto::response& res)
+{
+    res.set_start_line(
+        http_proto::status::ok);
+    res.append({
+        { http_proto::field::server, "boost" },
+        { http_proto::field::date,
+            "Sun, 06 Nov 1994 08:49:37 GMT" },
+        { http_proto::field::content_type,
+            "text/html; charset=utf-8" },
+        { http_proto::field::cache_control,
+            "no-cache, no-store, must-revalidate" },
+        { http_proto::field::vary,
+            "Accept-Encoding" },
+        { http_proto::field::etag,
+            "\"33a64df551425fcc55e4d42a148795d9f25f89d4\"" },
+        { http_proto::field::content_length, "4096" },
+        { http_proto::field::connection, "keep-alive" } });
+    return res.buffer().size();
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t const bytes = [&]
+    {
+        http_proto::response res;
+        return build(res);
+    }();
+
+    bench::add("response/heap",
+        batch * bytes, batch,
+        []
+        {
+            for(std::size_t i = 0; i < batch; ++i)
+            {
+                http_proto::response res;
+                bench::do_not_optimize(build(res));
+            }
+        });
+
+    bench::add("response/heap/list",
+        batch * bytes, batch,
+        []
+        {
+            for(std::size_t i = 0; i < batch; ++i)
+            {
+                http_proto::response res;
+                bench::do_not_optimize(build_list(res));
+            }
+        });
+
+    std::string storage(64 * 1024, 0);
+    bench::add("response/arena",
+        batch * bytes, batch,
+        [&storage]
+        {
+            pmr::monotonic_buffer_resource arena(
+                &storage[0], storage.size());
+            for(std::size_t i = 0; i < batch; ++i)
+            {
+                http_proto::response res(arena);
+                bench::do_not_optimize(build(res));
+            }
+        });
+
+    bench::add("response/inline",
+        batch * bytes, batch,
+        []
+        {
+            for(std::size_t i = 0; i < batch; ++i)
+            {
+                http_proto::static_response<1024> res;
+                bench::do_not_optimize(build(res));
+            }
+        });
+
+    return bench::run(argc, argv);
+}
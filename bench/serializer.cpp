@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Measures the serializer for each style of
+// body, with Content-Length and chunked framing.
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "bench.hpp"
+
+namespace http_proto = boost::http_proto;
+namespace buffers = boost::buffers;
+namespace core = boost::core;
+
+namespace {
+
+// supplies the body from memory
+struct memory_source
+    : http_proto::source
+{
+    core::string_view s_;
+
+    explicit
+    memory_source(
+        core::string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    results
+    on_read(
+        buffers::mutable_buffer b) override
+    {
+        results rv;
+        rv.bytes = buffers::buffer_copy(b,
+            buffers::const_buffer(
+                s_.data(), s_.size()));
+        s_.remove_prefix(rv.bytes);
+        rv.finished = s_.empty();
+        return rv;
+    }
+};
+
+// Consumes all of the output, as a
+// socket accepting every write would.
+std::size_t
+drain(http_proto::serializer& sr)
+{
+    std::size_t total = 0;
+    while(! sr.is_done())
+    {
+        auto rv = sr.prepare();
+        if(! rv)
+        {
+            std::cerr << "serialize failed: " <<
+                rv.error().message() << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        auto const n =
+            buffers::buffer_size(*rv);
+        sr.consume(n);
+        total += n;
+    }
+    return total;
+}
+
+// Sends whatever output is ready, as a
+// writer polling after each commit would.
+std::size_t
+drain_some(
+    http_proto::serializer& sr,
+    std::size_t& writes)
+{
+    std::size_t total = 0;
+    while(! sr.is_done())
+    {
+        auto rv = sr.prepare();
+        if(! rv)
+            break;
+        auto const n =
+            buffers::buffer_size(*rv);
+        sr.consume(n);
+        total += n;
+        ++writes;
+    }
+    return total;
+}
+
+// Writes the body through a stream, at most
+// `step` bytes per commit, sending whatever
+// is ready after each one.
+std::size_t
+write_stream(
+    http_proto::serializer& sr,
+    http_proto::response const& res,
+    core::string_view body,
+    std::size_t step = std::size_t(-1),
+    std::size_t threshold = 0,
+    std::size_t* writes = nullptr)
+{
+    std::size_t total = 0;
+    std::size_t w = 0;
+    auto st = sr.start_stream(res, threshold);
+    while(! body.empty())
+    {
+        if(st.is_full())
+        {
+            total += drain_some(sr, w);
+            continue;
+        }
+        auto n = body.size();
+        if( n > step)
+            n = step;
+        n = buffers::buffer_copy(
+            st.prepare(),
+            buffers::const_buffer(
+                body.data(), n));
+        st.commit(n);
+        body.remove_prefix(n);
+        if(step != std::size_t(-1))
+            total += drain_some(sr, w);
+    }
+    st.close();
+    total += drain_some(sr, w);
+    if(writes)
+        *writes = w;
+    return total;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    http_proto::context ctx;
+    http_proto::serializer sr(ctx);
+
+    std::string bodies[3] = {
+        std::string(256, '*'),
+        std::string(4096, '*'),
+        std::string(65536, '*') };
+    char const* const sizes[] = {
+        "/256", "/4k", "/64k" };
+
+    http_proto::response content_length[3];
+    http_proto::response chunked;
+    chunked.set_chunked(true);
+
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        auto const body = &bodies[i];
+        content_length[i].set_content_length(
+            body->size());
+        struct
+        {
+            char const* name;
+            http_proto::response const* res;
+        } const framings[] = {
+            { "/content-length", &content_length[i] },
+            { "/chunked", &chunked } };
+        for(auto const& fr : framings)
+        {
+            auto const r = fr.res;
+            auto const suffix =
+                std::string(fr.name) + sizes[i];
+            auto const bytes =
+                body->size() + r->buffer().size();
+
+            bench::add("buffers" + suffix, bytes, 1,
+                [&sr, r, body]
+                {
+                    sr.start(*r, buffers::const_buffer(
+                        body->data(), body->size()));
+                    bench::do_not_optimize(drain(sr));
+                });
+            bench::add("source" + suffix, bytes, 1,
+                [&sr, r, body]
+                {
+                    sr.start<memory_source>(*r, *body);
+                    bench::do_not_optimize(drain(sr));
+                });
+            bench::add("stream" + suffix, bytes, 1,
+                [&sr, r, body]
+                {
+                    bench::do_not_optimize(
+                        write_stream(sr, *r, *body));
+                });
+        }
+    }
+
+    // many small writes, as when relaying
+    // the output of a template engine
+    {
+        auto const body = &bodies[2];
+        struct
+        {
+            char const* name;
+            http_proto::response const* res;
+            std::size_t threshold;
+        } const tiny[] = {
+            { "stream/chunked/tiny", &chunked, 0 },
+            { "stream/chunked/tiny/coalesce", &chunked, 4096 },
+            { "stream/content-length/tiny", &content_length[2], 0 },
+            { "stream/content-length/tiny/coalesce", &content_length[2], 4096 } };
+        for(auto const& t : tiny)
+        {
+            auto const r = t.res;
+            auto const threshold = t.threshold;
+            std::size_t writes = 0;
+            auto const wire = write_stream(
+                sr, *r, *body, 16, threshold, &writes);
+            std::printf("%-48s %12zu bytes %8zu writes\n",
+                t.name, wire, writes);
+            bench::add(t.name, body->size(), 1,
+                [&sr, r, body, threshold]
+                {
+                    bench::do_not_optimize(write_stream(
+                        sr, *r, *body, 16, threshold));
+                });
+        }
+    }
+
+    return bench::run(argc, argv);
+}
@@ -11,8 +11,11 @@
 #define BOOST_HTTP_PROTO_HPP
 
 #include <boost/http_proto/buffered_base.hpp>
+#include <boost/http_proto/byteranges_source.hpp>
 #include <boost/http_proto/context.hpp>
+#include <boost/http_proto/coroutine.hpp>
 #include <boost/http_proto/deflate.hpp>
+#include <boost/http_proto/digest.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
 #include <boost/http_proto/fields.hpp>
@@ -27,25 +30,36 @@
 #include <boost/http_proto/file_stdio.hpp>
 #include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/loopback_stream.hpp>
 #include <boost/http_proto/message_base.hpp>
 #include <boost/http_proto/message_view_base.hpp>
 #include <boost/http_proto/method.hpp>
+#include <boost/http_proto/mmap_body.hpp>
+#include <boost/http_proto/multipart_sink.hpp>
 #include <boost/http_proto/parser.hpp>
 #include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_base.hpp>
 #include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/request_view.hpp>
 #include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_base.hpp>
 #include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/response_template.hpp>
 #include <boost/http_proto/response_view.hpp>
 #include <boost/http_proto/serializer.hpp>
 #include <boost/http_proto/sink.hpp>
 #include <boost/http_proto/source.hpp>
+#include <boost/http_proto/static_fields.hpp>
+#include <boost/http_proto/static_request.hpp>
+#include <boost/http_proto/static_response.hpp>
 #include <boost/http_proto/status.hpp>
 #include <boost/http_proto/string_body.hpp>
 #include <boost/http_proto/version.hpp>
+#include <boost/http_proto/workspace_pool.hpp>
 
 #include <boost/http_proto/rfc/combine_field_values.hpp>
 #include <boost/http_proto/rfc/list_rule.hpp>
+#include <boost/http_proto/rfc/media_type.hpp>
 #include <boost/http_proto/rfc/parameter.hpp>
 #include <boost/http_proto/rfc/quoted_token_rule.hpp>
 #include <boost/http_proto/rfc/quoted_token_view.hpp>
@@ -53,6 +67,7 @@
 #include <boost/http_proto/rfc/transfer_encoding_rule.hpp>
 #include <boost/http_proto/rfc/upgrade_rule.hpp>
 
+#include <boost/http_proto/service/date_service.hpp>
 #include <boost/http_proto/service/service.hpp>
 #include <boost/http_proto/service/zlib_service.hpp>
 
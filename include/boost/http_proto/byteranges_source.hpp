@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BYTERANGES_SOURCE_HPP
+#define BOOST_HTTP_PROTO_BYTERANGES_SOURCE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A source producing a multipart/byteranges body
+
+    The body holds one part for each range of
+    the file, as sent in a 206 (Partial Content)
+    response to a request for several ranges.
+    The delimiters and the Content-Type and
+    Content-Range fields of each part are
+    generated as the serializer reads, and the
+    data of each range is read from the file
+    directly into the serializer's buffer, so
+    the body is never held in memory.
+
+    The length of the body is known upon
+    construction, so the response can be sent
+    with a Content-Length instead of chunked.
+
+    @par Example
+    @code
+    byteranges_source src(
+        std::move(f), size, ranges,
+        "video/mp4", boundary);
+    res.set_start_line(status::partial_content);
+    res.set(field::content_type,
+        "multipart/byteranges; boundary=" + boundary);
+    res.set_content_length(src.content_length());
+    sr.start<byteranges_source>(res, std::move(src));
+    @endcode
+
+    @see
+        <a href="https://www.rfc-editor.org/rfc/rfc9110#section-14.6"
+            >Media Type multipart/byteranges (rfc9110)</a>
+*/
+class BOOST_SYMBOL_VISIBLE
+    byteranges_source
+    : public source
+{
+public:
+    /** A range of bytes in the file
+    */
+    struct range
+    {
+        /// The offset of the first byte
+        std::uint64_t first;
+
+        /// The offset of the last byte
+        std::uint64_t last;
+    };
+
+    byteranges_source(
+        byteranges_source const&) = delete;
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    byteranges_source(
+        byteranges_source&&) noexcept;
+
+    /** Destructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~byteranges_source();
+
+    /** Constructor
+
+        @throws std::invalid_argument `ranges`
+        is empty, a range is empty or does not
+        lie within `size` bytes, or `boundary`
+        is empty or longer than 70 characters.
+
+        @param f The open file.
+
+        @param size The complete length of the
+        representation, sent in each
+        Content-Range field.
+
+        @param ranges The ranges to send, in
+        the order given.
+
+        @param content_type The media type of
+        the file, or empty to omit the
+        Content-Type field of each part.
+
+        @param boundary The boundary delimiter,
+        which must not occur in the data.
+    */
+    BOOST_HTTP_PROTO_DECL
+    byteranges_source(
+        file&& f,
+        std::uint64_t size,
+        std::vector<range> ranges,
+        core::string_view content_type,
+        core::string_view boundary);
+
+    /** Return the size of the body in bytes
+    */
+    std::uint64_t
+    content_length() const noexcept
+    {
+        return length_;
+    }
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_read(
+        buffers::mutable_buffer b) override;
+
+private:
+    void format(std::size_t i);
+
+    file f_;
+    std::uint64_t size_;
+    std::vector<range> ranges_;
+    std::string type_;
+    std::string boundary_;
+
+    // the delimiter and fields
+    // preceding part i_, or the
+    // close delimiter
+    std::string head_;
+    std::size_t pos_ = 0;
+    std::size_t i_ = 0;
+    std::uint64_t left_ = 0;
+    std::uint64_t length_ = 0;
+    bool seek_ = false;
+};
+
+} // http_proto
+} // boost
+
+#endif
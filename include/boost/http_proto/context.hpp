@@ -13,6 +13,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/service/service.hpp>
 #include <boost/http_proto/detail/type_index.hpp>
+#include <cstddef>
 #include <memory>
 
 namespace boost {
@@ -49,6 +50,8 @@ public:
 
         @throw std::invalid_argument `find_service<T> != nullptr`
 
+        @throw std::logic_error The context is frozen.
+
         @return A reference to the new service.
 
         @tparam T The service type.
@@ -125,6 +128,40 @@ public:
     T&
     get_service() const;
 
+    /** Make the set of services read-only
+
+        After installing services, this may be
+        called to prepare the context for use
+        by many threads. The services are placed
+        in a table indexed by a number assigned
+        to each service type, so that finding
+        a service becomes an array access which
+        shares no mutable state between threads.
+
+        No services may be added afterwards.
+        Calling this more than once has no
+        further effect.
+
+        @par Thread Safety
+        This must not be called concurrently
+        with any other member function, and
+        must complete before other threads
+        begin finding services.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    freeze();
+
+    /** Return true if the context is frozen
+
+        @see @ref freeze.
+    */
+    bool
+    is_frozen() const noexcept
+    {
+        return frozen_;
+    }
+
 private:
     BOOST_HTTP_PROTO_DECL
     service*
@@ -135,9 +172,15 @@ private:
     service&
     make_service_impl(
         detail::type_index ti,
+        std::size_t slot,
         std::unique_ptr<service> sp);
 
     std::unique_ptr<data> p_;
+
+    // set by freeze()
+    service* const* slots_ = nullptr;
+    std::size_t n_slots_ = 0;
+    bool frozen_ = false;
 };
 
 } // http_proto
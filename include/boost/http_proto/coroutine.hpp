@@ -0,0 +1,547 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_COROUTINE_HPP
+#define BOOST_HTTP_PROTO_COROUTINE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_CO_AWAIT
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/system/error_code.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+#ifndef BOOST_HTTP_PROTO_DOCS
+template<class T = void>
+class task;
+#endif
+
+namespace detail {
+
+// Coroutine frames are recycled through a
+// small per-thread list of freed blocks.
+// The adaptors below create frames of the
+// same few sizes for every message, so after
+// the first message no frame is allocated.
+class frame_cache
+{
+    struct block
+    {
+        block* next;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t max_blocks = 16;
+
+    block* head_ = nullptr;
+    std::size_t n_ = 0;
+
+    static
+    std::size_t
+    round(std::size_t n) noexcept
+    {
+        return n < sizeof(block) ?
+            sizeof(block) : n;
+    }
+
+public:
+    frame_cache() = default;
+    frame_cache(frame_cache const&) = delete;
+    frame_cache& operator=(
+        frame_cache const&) = delete;
+
+    ~frame_cache()
+    {
+        while(head_)
+        {
+            auto const b = head_;
+            head_ = b->next;
+            ::operator delete(b);
+        }
+    }
+
+    static
+    frame_cache&
+    get() noexcept
+    {
+        thread_local frame_cache c;
+        return c;
+    }
+
+    void*
+    allocate(std::size_t n)
+    {
+        n = round(n);
+        for(auto pp = &head_; *pp;
+            pp = &(*pp)->next)
+        {
+            if((*pp)->size != n)
+                continue;
+            auto const b = *pp;
+            *pp = b->next;
+            --n_;
+            return b;
+        }
+        return ::operator new(n);
+    }
+
+    void
+    deallocate(
+        void* p,
+        std::size_t n) noexcept
+    {
+        if(n_ >= max_blocks)
+        {
+            ::operator delete(p);
+            return;
+        }
+        head_ = ::new(p) block{
+            head_, round(n) };
+        ++n_;
+    }
+};
+
+class task_promise_base
+{
+    template<class>
+    friend class http_proto::task;
+
+    std::coroutine_handle<> cont_;
+    std::exception_ptr ep_;
+
+    struct final_awaiter
+    {
+        bool
+        await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // symmetric transfer to the awaiter
+        template<class Promise>
+        std::coroutine_handle<>
+        await_suspend(
+            std::coroutine_handle<
+                Promise> h) noexcept
+        {
+            auto const c =
+                h.promise().cont_;
+            if(c)
+                return c;
+            return std::noop_coroutine();
+        }
+
+        void
+        await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    static
+    void*
+    operator new(std::size_t n)
+    {
+        return frame_cache::get().allocate(n);
+    }
+
+    static
+    void
+    operator delete(
+        void* p,
+        std::size_t n) noexcept
+    {
+        frame_cache::get().deallocate(p, n);
+    }
+
+    std::suspend_always
+    initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    final_awaiter
+    final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void
+    unhandled_exception() noexcept
+    {
+        ep_ = std::current_exception();
+    }
+
+protected:
+    void
+    rethrow() const
+    {
+        if(ep_)
+            std::rethrow_exception(ep_);
+    }
+};
+
+template<class T>
+class task_promise
+    : public task_promise_base
+{
+    std::optional<T> v_;
+
+public:
+    task<T>
+    get_return_object() noexcept;
+
+    template<class U>
+    void
+    return_value(U&& u)
+    {
+        v_.emplace(std::forward<U>(u));
+    }
+
+    T
+    result()
+    {
+        rethrow();
+        return std::move(*v_);
+    }
+};
+
+template<>
+class task_promise<void>
+    : public task_promise_base
+{
+public:
+    task<void>
+    get_return_object() noexcept;
+
+    void
+    return_void() noexcept
+    {
+    }
+
+    void
+    result()
+    {
+        rethrow();
+    }
+};
+
+} // detail
+
+//------------------------------------------------
+
+/** A lazily started coroutine
+
+    The coroutine begins when the task is
+    awaited, and on completion resumes its
+    awaiter directly by symmetric transfer,
+    so chains of tasks use no stack and
+    need no scheduler. Frames are recycled
+    per thread, so a task started for each
+    message does not allocate once the
+    first message has been processed.
+
+    @tparam T The type of the result.
+*/
+template<class T>
+class task
+{
+public:
+#ifndef BOOST_HTTP_PROTO_DOCS
+    using promise_type =
+        detail::task_promise<T>;
+#endif
+
+    task(task const&) = delete;
+    task& operator=(task const&) = delete;
+
+    /** Constructor
+    */
+    task(task&& other) noexcept
+        : h_(std::exchange(other.h_, nullptr))
+    {
+    }
+
+    /** Assignment
+    */
+    task&
+    operator=(task&& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(h_)
+                h_.destroy();
+            h_ = std::exchange(
+                other.h_, nullptr);
+        }
+        return *this;
+    }
+
+    /** Destructor
+    */
+    ~task()
+    {
+        if(h_)
+            h_.destroy();
+    }
+
+#ifndef BOOST_HTTP_PROTO_DOCS
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<>
+    await_suspend(
+        std::coroutine_handle<> c) noexcept
+    {
+        h_.promise().cont_ = c;
+        return h_;
+    }
+
+    T
+    await_resume()
+    {
+        return h_.promise().result();
+    }
+#endif
+
+private:
+    friend class detail::task_promise<T>;
+
+    template<class U>
+    friend
+    U
+    run_inline(task<U>);
+
+    explicit
+    task(std::coroutine_handle<
+        promise_type> h) noexcept
+        : h_(h)
+    {
+    }
+
+    std::coroutine_handle<promise_type> h_;
+};
+
+#ifndef BOOST_HTTP_PROTO_DOCS
+namespace detail {
+
+template<class T>
+task<T>
+task_promise<T>::
+get_return_object() noexcept
+{
+    return task<T>(std::coroutine_handle<
+        task_promise>::from_promise(*this));
+}
+
+inline
+task<void>
+task_promise<void>::
+get_return_object() noexcept
+{
+    return task<void>(std::coroutine_handle<
+        task_promise>::from_promise(*this));
+}
+
+} // detail
+#endif
+
+/** Run a task which never suspends
+
+    The task is run to completion on the
+    calling thread and its result returned.
+    This is only meaningful when every
+    operation awaited by the task completes
+    immediately, as with @ref loopback_stream.
+
+    @throws std::logic_error The task
+    suspended before completing.
+*/
+template<class T>
+T
+run_inline(task<T> t)
+{
+    t.h_.resume();
+    if(! t.h_.done())
+        detail::throw_logic_error();
+    return t.h_.promise().result();
+}
+
+//------------------------------------------------
+
+/** Read a message header from a stream
+
+    Input is read from the stream into the
+    parser until the header is complete.
+    Body octets which arrive along with the
+    header stay in the parser for a later
+    call to @ref co_read_body.
+
+    The `Stream` type must provide this
+    member, where the returned object is
+    awaitable and yields the number of
+    bytes read. A result of zero with no
+    error indicates the end of the stream.
+
+    @code
+    read_some(
+        parser::mutable_buffers_type const& b,
+        system::error_code& ec);
+    @endcode
+
+    @return The error, if any. This is
+    @ref error::end_of_stream when the
+    stream ended cleanly before a message.
+
+    @param s The stream to read from.
+
+    @param pr The parser, after
+    `start` has been called.
+*/
+template<class Stream>
+task<system::error_code>
+co_read_header(
+    Stream& s,
+    parser& pr)
+{
+    for(;;)
+    {
+        system::error_code ec;
+        pr.parse(ec);
+        if(pr.got_header())
+        {
+            if(ec == condition::need_more_input)
+                ec = {};
+            co_return ec;
+        }
+        if(ec != condition::need_more_input)
+            co_return ec;
+
+        auto const n = co_await s.read_some(
+            pr.prepare(), ec);
+        if(ec.failed())
+            co_return ec;
+        if(n == 0)
+            pr.commit_eof();
+        else
+            pr.commit(n);
+    }
+}
+
+/** Read the rest of a message from a stream
+
+    Input is read from the stream into the
+    parser until the message is complete.
+    The body is stored as arranged by the
+    caller with `set_body`, or in place.
+
+    @return The error, if any.
+
+    @param s The stream to read from,
+    meeting the requirements described in
+    @ref co_read_header.
+
+    @param pr The parser, after the header
+    has been read.
+*/
+template<class Stream>
+task<system::error_code>
+co_read_body(
+    Stream& s,
+    parser& pr)
+{
+    while(! pr.is_complete())
+    {
+        system::error_code ec;
+        pr.parse(ec);
+        if(pr.is_complete())
+            break;
+        if(ec != condition::need_more_input)
+            co_return ec;
+
+        auto const n = co_await s.read_some(
+            pr.prepare(), ec);
+        if(ec.failed())
+            co_return ec;
+        if(n == 0)
+            pr.commit_eof();
+        else
+            pr.commit(n);
+    }
+    co_return system::error_code();
+}
+
+/** Write a message to a stream
+
+    Output from the serializer is written
+    to the stream until the message is done.
+
+    The `Stream` type must provide this
+    member, where the returned object is
+    awaitable and yields the number of
+    bytes written.
+
+    @code
+    write_some(
+        serializer::const_buffers_type const& b,
+        system::error_code& ec);
+    @endcode
+
+    @return The error, if any. When this
+    is @ref error::expect_100_continue or
+    @ref error::need_data, the function may
+    be called again to continue writing.
+
+    @param s The stream to write to.
+
+    @param sr The serializer, after
+    `start` has been called.
+*/
+template<class Stream>
+task<system::error_code>
+co_write_message(
+    Stream& s,
+    serializer& sr)
+{
+    while(! sr.is_done())
+    {
+        auto rv = sr.prepare();
+        if(rv.has_error())
+            co_return rv.error();
+        system::error_code ec;
+        auto const n = co_await s.write_some(
+            rv.value(), ec);
+        if(ec.failed())
+            co_return ec;
+        sr.consume(n);
+    }
+    co_return system::error_code();
+}
+
+} // http_proto
+} // boost
+
+#endif
+
+#endif
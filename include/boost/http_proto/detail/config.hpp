@@ -37,6 +37,13 @@ namespace http_proto {
 #   define BOOST_HTTP_PROTO_ZLIB_DECL   BOOST_SYMBOL_IMPORT
 #  endif
 
+#  if defined(BOOST_HTTP_PROTO_BROTLI_SOURCE)
+#   define BOOST_HTTP_PROTO_BROTLI_DECL BOOST_SYMBOL_EXPORT
+#   define BOOST_HTTP_PROTO_BROTLI_BUILD_DLL
+#  else
+#   define BOOST_HTTP_PROTO_BROTLI_DECL BOOST_SYMBOL_IMPORT
+#  endif
+
 #  if defined(BOOST_HTTP_PROTO_EXT_SOURCE)
 #   define BOOST_HTTP_PROTO_EXT_DECL   BOOST_SYMBOL_EXPORT
 #   define BOOST_HTTP_PROTO_EXT_BUILD_DLL
@@ -53,6 +60,10 @@ namespace http_proto {
 #  define BOOST_HTTP_PROTO_ZLIB_DECL
 # endif
 
+# ifndef  BOOST_HTTP_PROTO_BROTLI_DECL
+#  define BOOST_HTTP_PROTO_BROTLI_DECL
+# endif
+
 # ifndef  BOOST_HTTP_PROTO_EXT_DECL
 #  define BOOST_HTTP_PROTO_EXT_DECL
 # endif
@@ -74,6 +85,37 @@ namespace http_proto {
 # define BOOST_HTTP_PROTO_AGGREGATE_WORKAROUND
 #endif
 
+// Use SIMD instructions when scanning headers
+#ifndef BOOST_HTTP_PROTO_NO_SSE2
+# if (defined(_M_IX86) && _M_IX86_FP == 2) || \
+      defined(_M_X64) || defined(__SSE2__)
+#  define BOOST_HTTP_PROTO_USE_SSE2
+# endif
+#endif
+
+#if defined(BOOST_HTTP_PROTO_USE_SSE2) && \
+    defined(__AVX2__) && \
+    ! defined(BOOST_HTTP_PROTO_NO_AVX2)
+# define BOOST_HTTP_PROTO_USE_AVX2
+#endif
+
+// Use the CRC32 instruction for crc32c
+#if defined(BOOST_HTTP_PROTO_USE_SSE2) && \
+    defined(__SSE4_2__) && \
+    ! defined(BOOST_HTTP_PROTO_NO_SSE42)
+# define BOOST_HTTP_PROTO_USE_SSE42
+#endif
+
+// C++20 coroutine adaptors
+#if defined(__cpp_impl_coroutine) && \
+    ! defined(BOOST_HTTP_PROTO_NO_CO_AWAIT)
+# if defined(__has_include)
+#  if __has_include(<coroutine>)
+#   define BOOST_HTTP_PROTO_HAS_CO_AWAIT
+#  endif
+# endif
+#endif
+
 // holds any offset within headers
 using offset_type = ::uint32_t; // private
 
@@ -18,8 +18,10 @@
 #include <boost/http_proto/method.hpp>
 #include <boost/http_proto/status.hpp>
 #include <boost/http_proto/version.hpp>
+#include <boost/container/container_fwd.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/assert.hpp>
+#include <atomic>
 #include <cstdint>
 #include <type_traits>
 
@@ -38,6 +40,8 @@ enum kind : unsigned char
     response,
 };
 
+struct target_cache;
+
 struct empty
 {
     kind param;
@@ -122,6 +126,51 @@ struct header
         entry* p_;
     };
 
+    // The set of known fields which appear
+    // in the table. A field whose bit is
+    // clear is absent, so lookups for it
+    // need not scan. Bits are set on insert
+    // and cleared when the last occurrence
+    // is erased. Present fields are still
+    // found by a scan which stops at the
+    // first match.
+    struct id_set
+    {
+        static constexpr std::size_t N =
+            (static_cast<std::size_t>(
+                field::xref) + 64) / 64;
+
+        std::uint64_t bits[N] = {};
+
+        bool
+        contains(field id) const noexcept
+        {
+            // unknown fields are not indexed
+            auto const i =
+                static_cast<std::size_t>(id);
+            return i == 0 ||
+                ((bits[i / 64] >> (i % 64)) & 1);
+        }
+
+        void
+        insert(field id) noexcept
+        {
+            auto const i =
+                static_cast<std::size_t>(id);
+            bits[i / 64] |=
+                std::uint64_t(1) << (i % 64);
+        }
+
+        void
+        erase(field id) noexcept
+        {
+            auto const i =
+                static_cast<std::size_t>(id);
+            bits[i / 64] &=
+                ~(std::uint64_t(1) << (i % 64));
+        }
+    };
+
     struct fld_t
     {
     };
@@ -147,6 +196,14 @@ struct header
     std::size_t cap = 0;
     std::size_t max_cap = max_capacity_in_bytes();
 
+    // allocates buf, or null
+    // for the global heap
+    container::pmr::memory_resource* mr = nullptr;
+
+    // the parsed request-target, owned
+    // by the container or parser, or null
+    target_cache* tc = nullptr;
+
     offset_type size = 0;
     offset_type count = 0;
     offset_type prefix = 0;
@@ -154,6 +211,21 @@ struct header
     http_proto::version version =
         http_proto::version::http_1_1;
     metadata md;
+    id_set ids;
+
+    // owned by the parser when it defers
+    // the lookup of ids for fields which
+    // do not affect the payload or routing,
+    // or null. These are stored as
+    // field::unknown until the first reader
+    // claims the state and looks them up.
+    enum : unsigned char
+    {
+        lazy_done = 0,
+        lazy_pending,
+        lazy_busy
+    };
+    std::atomic<unsigned char>* lazy = nullptr;
 
     union
     {
@@ -199,6 +271,8 @@ public:
     void copy_table(void*, std::size_t) const noexcept;
     void copy_table(void*) const noexcept;
     void assign_to(header&) const noexcept;
+    char* allocate(std::size_t n) const;
+    void deallocate(char*, std::size_t n) const noexcept;
 
     // metadata
 
@@ -208,11 +282,13 @@ public:
     void on_insert(field, core::string_view);
     void on_erase(field);
     void on_insert_connection(core::string_view);
+    void on_insert_content_encoding(core::string_view);
     void on_insert_content_length(core::string_view);
     void on_insert_expect(core::string_view);
     void on_insert_transfer_encoding();
     void on_insert_upgrade(core::string_view);
     void on_erase_connection();
+    void on_erase_content_encoding();
     void on_erase_content_length();
     void on_erase_expect();
     void on_erase_transfer_encoding();
@@ -227,6 +303,10 @@ public:
     BOOST_HTTP_PROTO_DECL void parse(
         std::size_t, header_limits const&,
             system::error_code&) noexcept;
+    static field eager_field(
+        core::string_view) noexcept;
+    void index() const noexcept;
+    void index(field) const noexcept;
 };
 
 } // detail
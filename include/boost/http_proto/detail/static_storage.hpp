@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_STATIC_STORAGE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_STATIC_STORAGE_HPP
+
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+// Allocates the buffer while it is
+// free and large enough, else from
+// the global heap
+class inline_resource
+    : public container::pmr::memory_resource
+{
+    char* p_;
+    std::size_t n_;
+    bool used_ = false;
+
+    void*
+    do_allocate(
+        std::size_t n,
+        std::size_t) override
+    {
+        if( used_ || n > n_)
+            return new char[n];
+        used_ = true;
+        return p_;
+    }
+
+    void
+    do_deallocate(
+        void* p,
+        std::size_t,
+        std::size_t) override
+    {
+        if(p != p_)
+        {
+            delete[] static_cast<char*>(p);
+            return;
+        }
+        used_ = false;
+    }
+
+    bool
+    do_is_equal(
+        memory_resource const& mr)
+            const noexcept override
+    {
+        return this == &mr;
+    }
+
+public:
+    inline_resource(
+        char* p,
+        std::size_t n) noexcept
+        : p_(p)
+        , n_(n)
+    {
+    }
+};
+
+// Storage for the header inside a
+// container. This is a base class,
+// so that it outlives the header.
+template<std::size_t N>
+class static_storage
+{
+protected:
+    static constexpr std::size_t
+        inline_size = align_up(
+            N, alignof(header::entry));
+
+    static_storage() noexcept
+        : inline_mr_(
+            inline_buf_, inline_size)
+    {
+    }
+
+    // each container has its own
+    static_storage(
+        static_storage const&) = delete;
+    static_storage& operator=(
+        static_storage const&) = delete;
+
+    alignas(header::entry)
+        char inline_buf_[inline_size];
+    inline_resource inline_mr_;
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_TARGET_CACHE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_TARGET_CACHE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/url/url_view.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+// The parsed request-target of a header.
+// This is kept by the owner of the header,
+// and is valid while the target is found
+// at the same place in the buffer.
+//
+// Views are const, and may be read from
+// several threads at once, so the first
+// reader to claim the empty cache fills it
+// and then publishes it. Readers which lose
+// the race parse on their own. Only code
+// which modifies the header clears it.
+struct target_cache
+{
+    enum : unsigned char
+    {
+        empty = 0,
+        busy,
+        ready
+    };
+
+    std::atomic<unsigned char> state{empty};
+    char const* p = nullptr;
+    std::size_t n = 0;
+    system::error_code ec;
+    urls::url_view u;
+
+    void
+    clear() noexcept
+    {
+        state.store(empty,
+            std::memory_order_relaxed);
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -21,6 +21,8 @@ namespace boost {
 namespace http_proto {
 namespace detail {
 
+class workspace_pool;
+
 /** A contiguous buffer of storage used by algorithms.
 
     Objects of this type retain ownership of a
@@ -43,6 +45,10 @@ namespace detail {
     @li The unused area, which starts from the
         end of the reserved area and stretches
         until the beginning of the acquired area.
+
+    When the storage is borrowed from a pool,
+    it is only held between calls to @ref acquire
+    and @ref release.
 */
 class workspace
 {
@@ -51,6 +57,8 @@ class workspace
     unsigned char* head_ = nullptr;
     unsigned char* back_ = nullptr;
     unsigned char* end_ = nullptr;
+    workspace_pool* pool_ = nullptr;
+    std::size_t n_ = 0;
 
     template<class>
     struct any_impl;
@@ -97,6 +105,47 @@ public:
     allocate(
         std::size_t n);
 
+    /** Use storage borrowed from a pool.
+
+        No storage is held until @ref acquire
+        is called.
+
+        @throws std::logic_error this->size() > 0
+
+        @throws std::invalid_argument n == 0
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    allocate(
+        std::size_t n,
+        workspace_pool& pool);
+
+    /** Return true if storage is held.
+    */
+    bool
+    has_storage() const noexcept
+    {
+        return begin_ != nullptr;
+    }
+
+    /** Borrow storage from the pool.
+
+        This has no effect unless the storage
+        comes from a pool and is not held.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    acquire();
+
+    /** Clear the contents and return storage to the pool.
+
+        This has no effect unless the storage
+        comes from a pool.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    release() noexcept;
+
     /** Return a pointer to the unused area.
     */
     unsigned char*
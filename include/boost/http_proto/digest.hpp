@@ -0,0 +1,283 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DIGEST_HPP
+#define BOOST_HTTP_PROTO_DIGEST_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/sink.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+/** An incremental CRC-32C checksum
+
+    This computes the CRC with the Castagnoli
+    polynomial, as used by the `crc32c` digest
+    algorithm, over data supplied in any
+    number of pieces.
+*/
+class crc32c
+{
+    std::uint32_t v_ = 0xffffffff;
+
+public:
+    /** The size of the digest in bytes
+    */
+    static constexpr std::size_t digest_size = 4;
+
+    /** The type of the digest
+    */
+    using digest_type =
+        std::array<unsigned char, digest_size>;
+
+    /** Add data to the checksum
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    update(
+        void const* data,
+        std::size_t size) noexcept;
+
+    /** Add data to the checksum
+    */
+    void
+    update(
+        buffers::const_buffer b) noexcept
+    {
+        update(b.data(), b.size());
+    }
+
+    /** Return the checksum of the data so far
+    */
+    std::uint32_t
+    value() const noexcept
+    {
+        return ~v_;
+    }
+
+    /** Return the checksum in network byte order
+    */
+    BOOST_HTTP_PROTO_DECL
+    digest_type
+    digest() const noexcept;
+};
+
+//------------------------------------------------
+
+/** An incremental SHA-256 hash
+
+    Data may be supplied in any number of
+    pieces. Calling @ref digest does not
+    end the computation, so the hash of the
+    data so far may be taken at any time.
+*/
+class sha256
+{
+    std::uint32_t h_[8];
+    std::uint64_t size_ = 0;
+    unsigned char buf_[64];
+
+public:
+    /** The size of the digest in bytes
+    */
+    static constexpr std::size_t digest_size = 32;
+
+    /** The type of the digest
+    */
+    using digest_type =
+        std::array<unsigned char, digest_size>;
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    sha256() noexcept;
+
+    /** Add data to the hash
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    update(
+        void const* data,
+        std::size_t size) noexcept;
+
+    /** Add data to the hash
+    */
+    void
+    update(
+        buffers::const_buffer b) noexcept
+    {
+        update(b.data(), b.size());
+    }
+
+    /** Return the hash of the data so far
+    */
+    BOOST_HTTP_PROTO_DECL
+    digest_type
+    digest() const noexcept;
+};
+
+//------------------------------------------------
+
+/** A sink which computes a digest of the body
+
+    The body is passed on to another sink,
+    and the digest is updated with each byte
+    that sink consumes. This allows a checksum
+    sent in the trailers, or in a header, to
+    be verified without first buffering the
+    body.
+
+    @par Example
+    @code
+    auto& ds = pr.set_body(
+        digest_sink< sha256, my_sink >( my_sink() ) );
+    pr.parse( ec );
+    // ...
+    auto d = ds.hash().digest();
+    @endcode
+
+    @tparam Digest The digest algorithm,
+        such as @ref crc32c or @ref sha256.
+
+    @tparam Sink The sink receiving the body.
+*/
+template<class Digest, class Sink>
+class digest_sink
+    : public sink
+{
+    Digest d_;
+    Sink s_;
+
+public:
+    /** Constructor
+    */
+    explicit
+    digest_sink(Sink s)
+        : s_(std::move(s))
+    {
+    }
+
+    /** Return the digest of the body so far
+    */
+    Digest const&
+    hash() const noexcept
+    {
+        return d_;
+    }
+
+    /** Return the sink receiving the body
+    */
+    Sink&
+    next() noexcept
+    {
+        return s_;
+    }
+
+private:
+    void
+    on_init(allocator& a) override
+    {
+        s_.init(a);
+    }
+
+    results
+    on_write(
+        buffers::const_buffer b,
+        bool more) override
+    {
+        auto rv = s_.write(b, more);
+        d_.update(b.data(), rv.bytes);
+        return rv;
+    }
+};
+
+/** A source which computes a digest of the body
+
+    The body is read from another source, and
+    the digest is updated with each byte it
+    produces.
+
+    @tparam Digest The digest algorithm,
+        such as @ref crc32c or @ref sha256.
+
+    @tparam Source The source producing the body.
+*/
+template<class Digest, class Source>
+class digest_source
+    : public source
+{
+    Digest d_;
+    Source s_;
+
+public:
+    /** Constructor
+
+        The arguments are forwarded to the
+        constructor of the source.
+    */
+    template<
+        class... Args
+#ifndef BOOST_HTTP_PROTO_DOCS
+        , class = typename std::enable_if<
+            std::is_constructible<
+                Source, Args...>::value>::type
+#endif
+    >
+    explicit
+    digest_source(Args&&... args)
+        : s_(std::forward<Args>(args)...)
+    {
+    }
+
+    /** Return the digest of the body so far
+    */
+    Digest const&
+    hash() const noexcept
+    {
+        return d_;
+    }
+
+    /** Return the source producing the body
+    */
+    Source&
+    next() noexcept
+    {
+        return s_;
+    }
+
+private:
+    void
+    on_init(allocator& a) override
+    {
+        s_.init(a);
+    }
+
+    results
+    on_read(
+        buffers::mutable_buffer b) override
+    {
+        auto rv = s_.read(b);
+        d_.update(b.data(), rv.bytes);
+        return rv;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -47,6 +47,10 @@ enum class error
     */
    need_data,
 
+    /** The body must be sent from a file
+    */
+   need_file,
+
     //--------------------------------------------
     //
     // Syntax errors (unrecoverable)
@@ -55,6 +59,9 @@ enum class error
     /// Invalid Connection field value
    bad_connection,
 
+    /// Invalid Content-Encoding field value
+   bad_content_encoding,
+
     /// Invalid Content-Length field value or values
    bad_content_length,
 
@@ -84,6 +91,9 @@ enum class error
     /// Syntax error in method
    bad_method,
 
+    /// Syntax error in a multipart body
+   bad_multipart,
+
     /// Syntax error in number
    bad_number,
 
@@ -15,6 +15,7 @@
 #include <boost/http_proto/fields_base.hpp>
 #include <boost/http_proto/fields_view.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <boost/assert.hpp>
 #include <initializer_list>
 
 namespace boost {
@@ -41,6 +42,39 @@ public:
     BOOST_HTTP_PROTO_DECL
     fields() noexcept;
 
+    /** Constructor
+
+        Construct an empty container whose storage
+        is allocated from `mr`, such as an
+        arena released when the work using
+        the container is done. Nothing is
+        allocated until the container is modified.
+
+        A container move constructed from this
+        one uses the same memory resource.
+        Move assignment from a container using
+        another resource copies it, and both
+        must use the same resource to swap.
+        Copies of the container use the global
+        heap.
+
+        @par Example
+        @code
+        boost::container::pmr::monotonic_buffer_resource arena;
+        boost::http_proto::fields f(arena);
+        f.set(boost::http_proto::field::host, "example.com");
+        @endcode
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the
+        resource must remain valid until the
+        storage is released.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    fields(
+        container::pmr::memory_resource& mr) noexcept;
+
     /** Constructor
     */
     BOOST_HTTP_PROTO_DECL
@@ -172,10 +206,14 @@ public:
     fields(fields_view const& other);
 
     /** Assignment
+
+        If the memory resources differ, the
+        contents are copied into storage from
+        this object's resource.
     */
     BOOST_HTTP_PROTO_DECL
     fields&
-    operator=(fields&& f) noexcept;
+    operator=(fields&& f);
 
     /** Assignment
     */
@@ -209,10 +247,17 @@ public:
     //--------------------------------------------
 
     /** Swap this with another instance
+
+        @par Preconditions
+        @code
+        this->resource() == other.resource()
+        @endcode
     */
     void
     swap(fields& other) noexcept
     {
+        BOOST_ASSERT(
+            h_.mr == other.h_.mr);
         h_.swap(other.h_);
     }
 
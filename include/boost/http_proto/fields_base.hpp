@@ -15,6 +15,8 @@
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/system/result.hpp>
+#include <initializer_list>
+#include <utility>
 
 namespace boost {
 namespace http_proto {
@@ -46,9 +48,18 @@ class fields_base
 
     friend class fields;
     friend class request;
+    friend class request_base;
     friend class response;
+    friend class response_base;
+    friend class response_template;
     friend class serializer;
     friend class message_base;
+    template<std::size_t>
+    friend class static_fields;
+    template<std::size_t>
+    friend class static_request;
+    template<std::size_t>
+    friend class static_response;
     friend struct detail::header;
     friend struct detail::prefix_op;
 
@@ -68,12 +79,19 @@ class fields_base
     fields_base(
         detail::kind) noexcept;
 
+    BOOST_HTTP_PROTO_DECL
+    fields_base(
+        detail::kind,
+        container::pmr::memory_resource*) noexcept;
+
     BOOST_HTTP_PROTO_DECL
     fields_base(
         detail::kind,
         core::string_view);
 
-    fields_base(detail::header const&);
+    fields_base(
+        detail::header const&,
+        container::pmr::memory_resource* = nullptr);
 
 public:
     /** Destructor
@@ -95,6 +113,22 @@ public:
         return h_.max_cap;
     }
 
+    /** Returns the memory resource used to allocate storage
+
+        A null pointer indicates that storage
+        is allocated with `new` and `delete`.
+        As with pmr containers, a moved-to
+        object keeps the resource of its
+        source, move assignment copies when
+        the resources differ, and copies use
+        the global heap.
+    */
+    container::pmr::memory_resource*
+    resource() const noexcept
+    {
+        return h_.mr;
+    }
+
     /** Returns the total number of bytes allocated by the container
     */
     std::size_t
@@ -214,6 +248,51 @@ public:
             h_.count);
     }
 
+    /** Append headers
+
+        This function appends a new header for
+        each id and value in the list, in order.
+        The storage is sized once for all of the
+        headers, so at most one reallocation
+        takes place. Every value must be
+        syntactically valid or else an error is
+        returned. Any leading or trailing
+        whitespace in the new values is ignored.
+        <br/>
+        No iterators are invalidated.
+
+        @par Example
+        @code
+        request req;
+
+        req.append({
+            { field::host, "example.com" },
+            { field::user_agent, "Boost" },
+            { field::accept, "text/html" } });
+        @endcode
+
+        @par Complexity
+        Linear in the total size of the names
+        and values.
+
+        @par Exception Safety
+        Strong guarantee, except that the
+        capacity may increase when an error
+        is returned.
+        Calls to allocate may throw.
+
+        @param init The ids and values. No id
+        may be @ref field::unknown.
+
+        @return The error for the first invalid
+        value, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    append(
+        std::initializer_list<std::pair<
+            field, core::string_view>> init);
+
     /** Insert a header
 
         If a matching header with the same name
@@ -497,6 +576,10 @@ private:
     copy_impl(
         detail::header const&);
 
+    BOOST_HTTP_PROTO_DECL
+    void
+    reallocate(std::size_t n);
+
     void
     insert_impl_unchecked(
         field id,
@@ -24,6 +24,10 @@ class BOOST_SYMBOL_VISIBLE
     : public fields_view_base
 {
     friend class fields;
+    friend class parser;
+    friend class multipart_sink;
+    template<std::size_t>
+    friend class static_fields;
 
 #ifndef BOOST_HTTP_PROTO_DOCS
 protected:
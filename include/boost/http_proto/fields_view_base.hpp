@@ -37,10 +37,18 @@ class fields_view_base
     friend class message_base;
     friend class message_view_base;
     friend class request;
+    friend class request_base;
     friend class request_view;
     friend class response;
+    friend class response_base;
     friend class response_view;
     friend class serializer;
+    template<std::size_t>
+    friend class static_fields;
+    template<std::size_t>
+    friend class static_request;
+    template<std::size_t>
+    friend class static_response;
 
     explicit
     fields_view_base(
@@ -26,6 +26,20 @@ class BOOST_SYMBOL_VISIBLE
     std::uint64_t n_;
 
 public:
+    /** A region of the file holding body data
+    */
+    struct region
+    {
+        /// The native handle of the open file
+        file::native_handle_type handle;
+
+        /// The offset of the first byte
+        std::uint64_t offset;
+
+        /// The number of bytes
+        std::uint64_t size;
+    };
+
     file_body() = delete;
     file_body(
         file_body const&) = delete;
@@ -44,6 +58,41 @@ public:
         std::uint64_t size =
             std::uint64_t(-1)) noexcept;
 
+    /** Return the region holding the unread body
+
+        The region starts at the current file
+        position. When the size passed upon
+        construction is unknown, the region
+        extends to the end of the file.
+
+        This allows the caller to transmit the
+        body directly from the file, for example
+        with `sendfile` or `splice`, instead of
+        copying it through @ref read.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    region
+    data(system::error_code& ec);
+
+    /** Skip body bytes which were sent by other means
+
+        The file position and the remaining size
+        are advanced by `n`.
+
+        @param n The number of bytes to skip. This
+        may not exceed the size of the region
+        returned by @ref data.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    consume(
+        std::uint64_t n,
+        system::error_code& ec);
+
     BOOST_HTTP_PROTO_DECL
     results
     on_read(
@@ -29,6 +29,25 @@ template<class T>
 using get_key_type =
     mp11::mp_eval_or<T, get_key_impl, T>;
 
+BOOST_HTTP_PROTO_DECL
+std::size_t
+next_service_slot() noexcept;
+
+// A small number for each service type,
+// used to index the table of a frozen
+// context. A type seen from more than
+// one shared library may receive more
+// than one number; lookups with an
+// unknown number use the slow path.
+template<class T>
+std::size_t
+service_slot() noexcept
+{
+    static std::size_t const n =
+        next_service_slot();
+    return n;
+}
+
 } // detail
 
 //------------------------------------------------
@@ -43,14 +62,18 @@ make_service(
         std::is_base_of<service, T>::value,
         "Type requirements not met.");
 
-    auto const ti = detail::get_type_index<
-        detail::get_key_type<T>>();
+    if(frozen_)
+        detail::throw_logic_error();
+    using key = detail::get_key_type<T>;
+    auto const ti =
+        detail::get_type_index<key>();
     auto const ps = find_service_impl(ti);
     if(ps)
         detail::throw_invalid_argument(
             "service exists");
     return detail::downcast<T&>(
         make_service_impl(ti,
+            detail::service_slot<key>(),
             std::unique_ptr<service>(
                 new T(*this, std::forward<
                     Args>(args)...))));
@@ -61,9 +84,14 @@ T*
 context::
 find_service() const noexcept
 {
-    auto const ti = detail::get_type_index<
-        detail::get_key_type<T>>();
-    auto const ps = find_service_impl(ti);
+    using key = detail::get_key_type<T>;
+    auto const i =
+        detail::service_slot<key>();
+    if( i < n_slots_ &&
+        slots_[i] != nullptr)
+        return detail::downcast<T*>(slots_[i]);
+    auto const ps = find_service_impl(
+        detail::get_type_index<key>());
     if(! ps)
         return nullptr;
     return detail::downcast<T*>(ps);
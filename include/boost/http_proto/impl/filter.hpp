@@ -13,7 +13,6 @@
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/buffers/range.hpp>
 #include <boost/buffers/type_traits.hpp>
-#include <boost/core/ignore_unused.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -132,13 +131,32 @@ process_impl(
     bool more) ->
         results
 {
-    boost::ignore_unused(more);
-    results rv;
+    // Only the first N buffers of each
+    // sequence are presented at once; the
+    // caller loops on the results as usual.
     constexpr int N = 16;
-    detail::unrolled<ConstBuffers, N> u0(in);
-    detail::unrolled<MutableBuffers, N> u1(out);
-
-    return rv;
+    buffers::mutable_buffer mb[N];
+    buffers::const_buffer cb[N];
+    std::size_t n1 = 0;
+    std::size_t n0 = 0;
+    {
+        auto it = buffers::begin(out);
+        auto const end_ = buffers::end(out);
+        while(
+            it != end_ &&
+            n1 < N)
+            mb[n1++] = *it++;
+    }
+    auto it0 = buffers::begin(in);
+    auto const end0 = buffers::end(in);
+    while(
+        it0 != end0 &&
+        n0 < N)
+        cb[n0++] = *it0++;
+    return on_process(
+        buffers::mutable_buffer_span(mb, n1),
+        buffers::const_buffer_span(cb, n0),
+        more || it0 != end0);
 }
 
 } // http_proto
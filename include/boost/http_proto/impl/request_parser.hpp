@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_IMPL_REQUEST_PARSER_HPP
+#define BOOST_HTTP_PROTO_IMPL_REQUEST_PARSER_HPP
+
+namespace boost {
+namespace http_proto {
+
+template<class Handler>
+std::size_t
+request_parser::
+parse_batch(
+    Handler&& f,
+    system::error_code& ec)
+{
+    std::size_t n = 0;
+    for(;;)
+    {
+        parse(ec);
+        if(ec == condition::need_more_input)
+        {
+            ec = {};
+            return n;
+        }
+        if( ec.failed() ||
+            ! is_complete())
+            return n;
+
+        f(get(), body());
+        ++n;
+        if(got_eof_)
+            return n;
+        start();
+
+        // nothing left to parse
+        if(fb_.size() == 0)
+            return n;
+    }
+}
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_LOOPBACK_STREAM_HPP
+#define BOOST_HTTP_PROTO_LOOPBACK_STREAM_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_CO_AWAIT
+
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <boost/buffers/range.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+/** An in-memory stream which reads what was written
+
+    Bytes written to the stream are appended
+    to an internal buffer, and reads consume
+    them in order. Every operation completes
+    immediately, so tasks using the stream
+    may be run with @ref run_inline. Reading
+    when no data is left reports the end of
+    the stream.
+
+    The amount transferred by each operation
+    may be limited, to exercise the handling
+    of partial reads and writes.
+
+    @see
+        @ref co_read_header,
+        @ref co_write_message.
+*/
+class loopback_stream
+{
+    std::string buf_;
+    std::size_t pos_ = 0;
+    std::size_t max_read_;
+    std::size_t max_write_;
+
+public:
+    /** An awaitable which is already complete
+    */
+    class result
+    {
+        std::size_t n_;
+
+    public:
+        explicit
+        result(std::size_t n) noexcept
+            : n_(n)
+        {
+        }
+
+        bool
+        await_ready() const noexcept
+        {
+            return true;
+        }
+
+        void
+        await_suspend(
+            std::coroutine_handle<>) const noexcept
+        {
+        }
+
+        std::size_t
+        await_resume() const noexcept
+        {
+            return n_;
+        }
+    };
+
+    /** Constructor
+
+        @param max_read The largest number of
+        bytes returned by each read.
+
+        @param max_write The largest number of
+        bytes accepted by each write.
+    */
+    explicit
+    loopback_stream(
+        std::size_t max_read = std::size_t(-1),
+        std::size_t max_write = std::size_t(-1))
+        : max_read_(max_read)
+        , max_write_(max_write)
+    {
+    }
+
+    /** Return the bytes written and not yet read
+    */
+    core::string_view
+    data() const noexcept
+    {
+        return core::string_view(
+            buf_.data() + pos_,
+            buf_.size() - pos_);
+    }
+
+    /** Discard all data
+
+        The capacity of the internal buffer
+        is kept for reuse.
+    */
+    void
+    clear() noexcept
+    {
+        buf_.clear();
+        pos_ = 0;
+    }
+
+    /** Append bytes to be read
+    */
+    void
+    append(core::string_view s)
+    {
+        buf_.append(s.data(), s.size());
+    }
+
+    /** Read some data
+    */
+    template<class MutableBufferSequence>
+    result
+    read_some(
+        MutableBufferSequence const& b,
+        system::error_code& ec)
+    {
+        ec = {};
+        auto avail = buf_.size() - pos_;
+        if( avail > max_read_)
+            avail = max_read_;
+        auto const n = buffers::buffer_copy(b,
+            buffers::const_buffer(
+                buf_.data() + pos_, avail));
+        pos_ += n;
+        if(pos_ == buf_.size())
+            clear();
+        return result(n);
+    }
+
+    /** Write some data
+    */
+    template<class ConstBufferSequence>
+    result
+    write_some(
+        ConstBufferSequence const& b,
+        system::error_code& ec)
+    {
+        ec = {};
+        std::size_t n = 0;
+        for(buffers::const_buffer cb :
+                buffers::range(b))
+        {
+            auto size = cb.size();
+            if( size > max_write_ - n)
+                size = max_write_ - n;
+            buf_.append(static_cast<
+                char const*>(cb.data()), size);
+            n += size;
+            if(n == max_write_)
+                break;
+        }
+        return result(n);
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
+
+#endif
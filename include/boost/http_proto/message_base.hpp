@@ -25,8 +25,8 @@ class message_base
     : public fields_base
     , public message_view_base
 {
-    friend class request;
-    friend class response;
+    friend class request_base;
+    friend class response_base;
 
     explicit
     message_base(
@@ -37,6 +37,15 @@ class message_base
     {
     }
 
+    message_base(
+        detail::kind k,
+        container::pmr::memory_resource& mr) noexcept
+        : fields_view_base(
+            &this->fields_base::h_)
+        , fields_base(k, &mr)
+    {
+    }
+
     message_base(
         detail::kind k,
         std::size_t storage_size)
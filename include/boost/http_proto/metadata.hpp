@@ -56,6 +56,39 @@ enum class payload
 
 //------------------------------------------------
 
+/** Identifies the coding applied to a body
+*/
+enum class encoding
+{
+    /**
+      * No coding is applied
+    */
+    identity
+
+    /**
+      * The deflate coding
+    */
+    ,deflate
+
+    /**
+      * The gzip coding
+    */
+    ,gzip
+
+    /**
+      * The brotli coding
+    */
+    ,br
+
+    /**
+      * A coding which cannot be decoded,
+      * or more than one coding
+    */
+    ,unknown
+};
+
+//------------------------------------------------
+
 /** Metadata about a request or response
 */
 struct metadata
@@ -146,6 +179,42 @@ struct metadata
 
     //--------------------------------------------
 
+    /** Metadata for the Content-Encoding field
+    */
+    struct content_encoding_t
+    {
+        /** Error status of Content-Encoding
+        */
+        system::error_code ec;
+
+        /** The total number of fields
+        */
+        std::size_t count = 0;
+
+        /** The content coding
+        */
+        http_proto::encoding encoding =
+            http_proto::encoding::identity;
+
+    #ifdef BOOST_HTTP_PROTO_AGGREGATE_WORKAROUND
+        constexpr
+        content_encoding_t() = default;
+
+        constexpr
+        content_encoding_t(
+            system::error_code ec_,
+            std::size_t count_,
+            http_proto::encoding encoding_) noexcept
+            : ec(ec_)
+            , count(count_)
+            , encoding(encoding_)
+        {
+        }
+    #endif
+    };
+
+    //--------------------------------------------
+
     /** Metadata for the Expect field
     */
     struct expect_t
@@ -201,6 +270,11 @@ struct metadata
         */
         bool is_chunked = false;
 
+        /** The coding applied before chunked, if any
+        */
+        http_proto::encoding encoding =
+            http_proto::encoding::identity;
+
     #ifdef BOOST_HTTP_PROTO_AGGREGATE_WORKAROUND
         constexpr
         transfer_encoding_t() = default;
@@ -210,11 +284,14 @@ struct metadata
             system::error_code ec_,
             std::size_t count_,
             std::size_t codings_,
-            bool is_chunked_) noexcept
+            bool is_chunked_,
+            http_proto::encoding encoding_ =
+                http_proto::encoding::identity) noexcept
             : ec(ec_)
             , count(count_)
             , codings(codings_)
             , is_chunked(is_chunked_)
+            , encoding(encoding_)
         {
         }
     #endif
@@ -285,6 +362,10 @@ struct metadata
     */
     connection_t connection;
 
+    /** Metadata for the Content-Encoding field.
+    */
+    content_encoding_t content_encoding;
+
     /** Metadata for the Content-Length field.
     */
     content_length_t content_length;
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_MMAP_BODY_HPP
+#define BOOST_HTTP_PROTO_MMAP_BODY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file_posix.hpp>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+
+#include <boost/http_proto/source.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** A source which maps a file into memory
+
+    The body is mapped one slice at a time, so
+    files larger than the address space can be
+    sent. When this source is passed to
+    @ref serializer::start, the buffers returned
+    by @ref serializer::prepare point directly
+    into the mapping, and the header and body
+    can be written with a single gather write
+    without copying the body into the workspace.
+
+    When a content coding is applied, or when
+    the body is read through @ref read, the
+    bytes are copied out of the mapping.
+*/
+class BOOST_SYMBOL_VISIBLE
+    mmap_body
+    : public source
+{
+    file_posix f_;
+    std::uint64_t pos_;     // file offset of the next byte
+    std::uint64_t n_;       // bytes remaining
+    std::size_t slice_;
+    void* map_ = nullptr;
+    std::size_t map_size_ = 0;
+    char const* p_ = nullptr;   // next byte in the mapping
+    std::size_t avail_ = 0;     // mapped bytes at p_
+
+    void unmap() noexcept;
+
+public:
+    /** The default largest number of bytes mapped at once
+    */
+    static constexpr std::size_t default_slice_size =
+        64 * 1024 * 1024;
+
+    mmap_body() = delete;
+    mmap_body(
+        mmap_body const&) = delete;
+
+    BOOST_HTTP_PROTO_DECL
+    mmap_body(
+        mmap_body&&) noexcept;
+
+    BOOST_HTTP_PROTO_DECL
+    ~mmap_body();
+
+    /** Constructor
+
+        The body starts at the current position
+        of the file.
+
+        @param f The open file.
+
+        @param size The number of bytes in the
+        body, or `std::uint64_t(-1)` to send the
+        rest of the file.
+
+        @param slice_size The largest number of
+        bytes mapped at once. This is rounded up
+        to a multiple of the page size.
+
+        @throws system_error The position or
+        size of the file could not be determined.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    mmap_body(
+        file_posix&& f,
+        std::uint64_t size =
+            std::uint64_t(-1),
+        std::size_t slice_size =
+            default_slice_size);
+
+    /** Return the number of body bytes not yet consumed
+    */
+    std::uint64_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the next mapped bytes of the body
+
+        When every byte of the current slice has
+        been consumed, the slice is unmapped and
+        the next one is mapped. The returned
+        buffer remains valid until its bytes are
+        consumed.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    buffers::const_buffer
+    data(system::error_code& ec);
+
+    /** Consume bytes returned by @ref data
+
+        @param n The number of bytes to consume.
+        This may not exceed the size of the buffer
+        returned by the last call to @ref data.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    consume(std::size_t n) noexcept;
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_read(
+        buffers::mutable_buffer b) override;
+};
+
+} // http_proto
+} // boost
+
+#endif
+
+#endif
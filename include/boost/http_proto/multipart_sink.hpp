@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2023 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_MULTIPART_SINK_HPP
+#define BOOST_HTTP_PROTO_MULTIPART_SINK_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view.hpp>
+#include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/sink.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+/** A sink which parses a multipart body
+
+    The body is split into parts as it
+    arrives, such as the fields and files of
+    a multipart/form-data upload. For each
+    part, the headers are passed to
+    @ref on_part, which returns the sink
+    receiving the body of that part. The
+    end of each body is indicated by a final
+    write with `more == false`.
+
+    Memory use is bounded by the limits on
+    the headers of a part, regardless of the
+    size of the body. The boundary delimiter
+    is located with a Boyer-Moore-Horspool
+    search, which usually examines only a
+    fraction of the bytes in each body.
+
+    The preamble before the first part and
+    the epilogue after the last are ignored.
+
+    @par Example
+    @code
+    class upload_sink : public multipart_sink
+    {
+        my_file_sink file_;
+
+        sink*
+        on_part(fields_view const& f) override
+        {
+            // select and open a file using
+            // the Content-Disposition field
+            return &file_;
+        }
+
+    public:
+        using multipart_sink::multipart_sink;
+    };
+
+    pr.set_body(upload_sink(pr.get().value_or(
+        field::content_type, "")));
+    @endcode
+
+    @see
+        <a href="https://www.rfc-editor.org/rfc/rfc2046#section-5.1"
+            >5.1. Multipart Media Type (rfc2046)</a>,
+        <a href="https://www.rfc-editor.org/rfc/rfc7578"
+            >Returning Values from Forms: multipart/form-data (rfc7578)</a>
+*/
+class BOOST_SYMBOL_VISIBLE
+    multipart_sink
+    : public sink
+{
+public:
+    multipart_sink(
+        multipart_sink const&) = delete;
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    multipart_sink(
+        multipart_sink&&) noexcept;
+
+    /** Destructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~multipart_sink();
+
+    /** Constructor
+
+        @throws std::invalid_argument
+        `content_type` is not a multipart
+        media type with a boundary parameter
+        of 1 to 70 characters.
+
+        @param content_type The value of the
+        Content-Type field of the message.
+
+        @param lim The limits on the headers
+        of each part.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    multipart_sink(
+        core::string_view content_type,
+        header_limits const& lim = {});
+
+    /** Return the boundary
+    */
+    core::string_view
+    boundary() const noexcept
+    {
+        return core::string_view(
+            delim_).substr(4);
+    }
+
+    /** Return the number of parts received
+    */
+    std::size_t
+    count() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return true if the close delimiter was received
+    */
+    bool
+    is_done() const noexcept
+    {
+        return st_ == state::epilogue;
+    }
+
+protected:
+    /** Called when the headers of a part are received
+
+        The returned sink receives the body of
+        the part, and must remain valid until
+        it is written with `more == false`.
+
+        @return The sink for the body, or
+        `nullptr` to discard the body.
+
+        @param f The headers of the part. The
+        view is invalidated when this function
+        returns.
+    */
+    virtual
+    sink*
+    on_part(fields_view const& f) = 0;
+
+private:
+    enum class state
+    {
+        preamble,
+        delim,
+        close,
+        padding,
+        lf,
+        header,
+        body,
+        epilogue
+    };
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_write(
+        buffers::const_buffer b,
+        bool more) override;
+
+    char const* find(
+        char const*, char const*) const noexcept;
+    char const* scan(char const*,
+        char const*, system::error_code&);
+    void emit(char const*, std::size_t,
+        system::error_code&);
+    void end_part(system::error_code&);
+    void start_header() noexcept;
+
+    // CRLF "--" boundary
+    std::string delim_;
+
+    // bytes which may begin a delimiter
+    std::string hold_;
+
+    // headers of the current part,
+    // followed by the field table
+    std::unique_ptr<char[]> hbuf_;
+    header_limits lim_;
+    detail::header h_;
+    std::size_t hn_ = 0;
+
+    sink* part_ = nullptr;
+    std::size_t n_ = 0;
+    state st_ = state::preamble;
+    unsigned char skip_[256];
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -12,12 +12,16 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/error.hpp>
+#include <boost/http_proto/fields_view.hpp>
 #include <boost/http_proto/header_limits.hpp>
 #include <boost/http_proto/sink.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/target_cache.hpp>
 #include <boost/http_proto/detail/type_traits.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
 #include <boost/buffers/circular_buffer.hpp>
+#include <boost/buffers/const_buffer_pair.hpp>
+#include <boost/buffers/const_buffer_span.hpp>
 #include <boost/buffers/flat_buffer.hpp>
 #include <boost/buffers/mutable_buffer_pair.hpp>
 #include <boost/buffers/mutable_buffer_span.hpp>
@@ -88,6 +92,39 @@ public:
         */
         bool apply_deflate_decoder = false;
 
+        /** True if parser can decode brotli content encodings.
+
+            The brotli decoder must already be
+            installed thusly, or else an exception
+            is thrown.
+
+            @par Install Brotli Decoder
+            @code
+            brotli::decoder_service::config cfg;
+            cfg.install( ctx );
+            @endcode
+        */
+        bool apply_brotli_decoder = false;
+
+        /** True if the parser defers the lookup of most field names.
+
+            When set, parsing only looks up the
+            names of the fields which affect the
+            payload, and Host. The other fields
+            are still validated, and their names
+            are looked up on the first access
+            through the parsed header which needs
+            them. This suits intermediaries which
+            forward most messages after routing.
+
+            Views of the parsed header may still
+            be read from several threads at once;
+            the first access which needs the names
+            looks them up, and the others wait for
+            it to finish.
+        */
+        bool lazy_fields = false;
+
         /** Minimum space for payload buffering.
 
             This value controls the following
@@ -337,6 +374,26 @@ public:
     core::string_view
     body() const noexcept;
 
+    /** Return the trailer fields of the message.
+
+        The fields which follow the last chunk
+        of a chunked body are returned. The view
+        is empty when there are none, or when
+        the body is not chunked.
+
+        The view is invalidated when @ref start
+        or @ref reset is called.
+
+        @par Preconditions
+        @ref is_complete returns `true`.
+
+        @throws std::logic_error
+        The message is not complete.
+    */
+    BOOST_HTTP_PROTO_DECL
+    fields_view
+    trailers() const;
+
     //--------------------------------------------
 
     /** Return any leftover data
@@ -359,7 +416,10 @@ private:
     detail::header const*
         safe_get_header() const;
     bool is_plain() const noexcept;
+    void init_header(std::size_t);
     void on_headers(system::error_code&);
+    void on_trailers(std::size_t, std::size_t,
+        system::error_code&);
     BOOST_HTTP_PROTO_DECL void on_set_body();
     void init_dynamic(system::error_code&);
 
@@ -388,9 +448,13 @@ private:
     parser_service& svc_;
     detail::workspace ws_;
     detail::header h_;
+    detail::header trailers_;
+    detail::target_cache tc_;
+    std::atomic<unsigned char> lazy_;
     std::uint64_t body_avail_;
     std::uint64_t body_total_;
     std::uint64_t payload_remain_;
+    std::uint64_t chunk_remain_;
     std::size_t nprepare_;
 
     buffers::flat_buffer fb_;
@@ -398,6 +462,7 @@ private:
     buffers::circular_buffer cb1_;
     buffers::circular_buffer* body_buf_;
     buffers::mutable_buffer_pair mbp_;
+    buffers::const_buffer_pair cbp_;
     buffers::any_dynamic_buffer* eb_;
     filter* filt_;
     sink* sink_;
@@ -407,6 +472,9 @@ private:
     bool got_eof_;
 //    bool need_more_;
     bool head_response_;
+    bool needs_chunk_close_;
+    bool chunked_body_ended_;
+    bool filter_done_;
 };
 
 //------------------------------------------------
@@ -11,8 +11,9 @@
 #define BOOST_HTTP_PROTO_REQUEST_HPP
 
 #include <boost/http_proto/detail/config.hpp>
-#include <boost/http_proto/message_base.hpp>
+#include <boost/http_proto/request_base.hpp>
 #include <boost/http_proto/request_view.hpp>
+#include <boost/assert.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -20,7 +21,7 @@ namespace http_proto {
 /** Container for HTTP requests
 */
 class request final
-    : public message_base
+    : public request_base
 {
 public:
     /** Constructor
@@ -28,6 +29,42 @@ public:
     BOOST_HTTP_PROTO_DECL
     request() noexcept;
 
+    /** Constructor
+
+        Construct an empty request whose storage
+        is allocated from `mr`, such as an
+        arena released when the work using
+        the request is done. Nothing is
+        allocated until the request is modified.
+
+        A request move constructed from this
+        one uses the same memory resource.
+        Move assignment from a request using
+        another resource copies it, and both
+        must use the same resource to swap.
+        Copies of the request use the global
+        heap.
+
+        @par Example
+        @code
+        // one arena for everything built while
+        // handling a request
+        boost::container::pmr::monotonic_buffer_resource arena;
+        boost::http_proto::request req(arena);
+        req.set_method(boost::http_proto::method::get);
+        req.set_target("/");
+        @endcode
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the
+        resource must remain valid until the
+        storage is released.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    request(
+        container::pmr::memory_resource& mr) noexcept;
+
     /** Constructor
     */
     BOOST_HTTP_PROTO_DECL
@@ -146,7 +183,8 @@ public:
 
         The moved-from object will be
         left in the default-constructed
-        state.
+        state, with the same memory
+        resource.
     */
     BOOST_HTTP_PROTO_DECL
     request(request&& other) noexcept;
@@ -163,10 +201,14 @@ public:
         request_view const& other);
 
     /** Assignment
+
+        If the memory resources differ, the
+        contents are copied into storage from
+        this object's resource.
     */
     BOOST_HTTP_PROTO_DECL
     request&
-    operator=(request&&) noexcept;
+    operator=(request&&);
 
     /** Assignment
     */
@@ -187,166 +229,18 @@ public:
         return *this;
     }
 
-    /** Return a read-only view to the request
-    */
-    operator
-    request_view() const noexcept
-    {
-        return request_view(ph_);
-    }
-
-    //--------------------------------------------
-    //
-    // Observers
-    //
-    //--------------------------------------------
-
-    /** Return the method as an integral constant
-
-        If the method returned is equal to
-        @ref method::unknown, the method may
-        be obtained as a string instead, by
-        calling @ref method_text.
-    */
-    http_proto::method
-    method() const noexcept
-    {
-        return ph_->req.method;
-    }
-
-    /** Return the method as a string
-    */
-    core::string_view
-    method_text() const noexcept
-    {
-        return core::string_view(
-            ph_->cbuf,
-            ph_->req.method_len);
-    }
-
-    /** Return the request-target string
-    */
-    core::string_view
-    target() const noexcept
-    {
-        return core::string_view(
-            ph_->cbuf +
-                ph_->req.method_len + 1,
-            ph_->req.target_len);
-    }
-
-    /** Return the HTTP-version
-    */
-    http_proto::version
-    version() const noexcept
-    {
-        return ph_->version;
-    }
-
-    //--------------------------------------------
-    //
-    // Modifiers
-    //
-    //--------------------------------------------
-
-    /** Set the method of the request to the enum
-    */
-    void
-    set_method(
-        http_proto::method m)
-    {
-        set_impl(
-            m,
-            to_string(m),
-            target(),
-            version());
-    }
-
-    /** Set the method of the request to the string
-    */
-    void
-    set_method(
-        core::string_view s)
-    {
-        set_impl(
-            string_to_method(s),
-            s,
-            target(),
-            version());
-    }
-
-    /** Set the target string of the request
-
-        This function sets the request-target.
-        The caller is responsible for ensuring
-        that the string passed is syntactically
-        valid.
-    */
-    void
-    set_target(
-        core::string_view s)
-    {
-        set_impl(
-            ph_->req.method,
-            method_text(),
-            s,
-            version());
-    }
-
-    /** Set the HTTP version of the request
-    */
-    void
-    set_version(
-        http_proto::version v)
-    {
-        set_impl(
-            ph_->req.method,
-            method_text(),
-            target(),
-            v);
-    }
-
-    /** Set the method, target, and version of the request
-
-        This is more efficient than setting the
-        properties individually.
-    */
-    void
-    set_start_line(
-        http_proto::method m,
-        core::string_view t,
-        http_proto::version v)
-    {
-        set_impl(m, to_string(m), t, v);
-    }
-
-    /** Set the method, target, and version of the request
-
-        This is more efficient than setting the
-        properties individually.
-    */
-    void
-    set_start_line(
-        core::string_view m,
-        core::string_view t,
-        http_proto::version v)
-    {
-        set_impl(string_to_method(m), m, t, v);
-    }
-
-    /** Set the Expect header
-    */
-    BOOST_HTTP_PROTO_DECL
-    void
-    set_expect_100_continue(bool b);
-
-    //--------------------------------------------
-
     /** Swap this with another instance
+
+        @par Preconditions
+        @code
+        this->resource() == other.resource()
+        @endcode
     */
     void
     swap(request& other) noexcept
     {
+        BOOST_ASSERT(
+            h_.mr == other.h_.mr);
         h_.swap(other.h_);
     }
 
@@ -361,15 +255,6 @@ public:
     {
         t0.swap(t1);
     }
-
-private:
-    BOOST_HTTP_PROTO_DECL
-    void
-    set_impl(
-        http_proto::method m,
-        core::string_view ms,
-        core::string_view t,
-        http_proto::version v);
 };
 
 } // http_proto
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_REQUEST_BASE_HPP
+#define BOOST_HTTP_PROTO_REQUEST_BASE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/message_base.hpp>
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/detail/target_cache.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** Mixin for modifiable HTTP requests
+
+    This provides the observers and modifiers
+    common to @ref request and @ref static_request.
+*/
+class BOOST_SYMBOL_VISIBLE
+    request_base
+    : public message_base
+{
+    friend class request;
+    template<std::size_t>
+    friend class static_request;
+
+    detail::target_cache tc_;
+
+    request_base() noexcept
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(
+            detail::kind::request)
+    {
+        h_.tc = &tc_;
+    }
+
+    explicit
+    request_base(
+        container::pmr::memory_resource& mr) noexcept
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(
+            detail::kind::request, mr)
+    {
+        h_.tc = &tc_;
+    }
+
+    explicit
+    request_base(
+        core::string_view s)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(
+            detail::kind::request, s)
+    {
+        h_.tc = &tc_;
+    }
+
+    explicit
+    request_base(
+        std::size_t storage_size)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(
+            detail::kind::request,
+            storage_size)
+    {
+        h_.tc = &tc_;
+    }
+
+    request_base(
+        std::size_t storage_size,
+        std::size_t max_storage_size)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(
+            detail::kind::request,
+            storage_size,
+            max_storage_size)
+    {
+        h_.tc = &tc_;
+    }
+
+    explicit
+    request_base(
+        detail::header const& ph)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , message_base(ph)
+    {
+        h_.tc = &tc_;
+    }
+
+public:
+    /** Return a read-only view to the request
+    */
+    operator
+    request_view() const noexcept
+    {
+        return request_view(ph_);
+    }
+
+    //--------------------------------------------
+    //
+    // Observers
+    //
+    //--------------------------------------------
+
+    /** Return the method as an integral constant
+
+        If the method returned is equal to
+        @ref method::unknown, the method may
+        be obtained as a string instead, by
+        calling @ref method_text.
+    */
+    http_proto::method
+    method() const noexcept
+    {
+        return ph_->req.method;
+    }
+
+    /** Return the method as a string
+    */
+    core::string_view
+    method_text() const noexcept
+    {
+        return core::string_view(
+            ph_->cbuf,
+            ph_->req.method_len);
+    }
+
+    /** Return the request-target string
+    */
+    core::string_view
+    target() const noexcept
+    {
+        return core::string_view(
+            ph_->cbuf +
+                ph_->req.method_len + 1,
+            ph_->req.target_len);
+    }
+
+    /** Return the request-target as a URL
+
+        The target is parsed on the first call,
+        as origin-form when it begins with a
+        slash and as absolute-form otherwise,
+        and the result is kept until the target
+        changes.
+
+        @see
+            @ref request_view::target_url.
+    */
+    system::result<urls::url_view>
+    target_url() const noexcept
+    {
+        return request_view(ph_).target_url();
+    }
+
+    /** Return the HTTP-version
+    */
+    http_proto::version
+    version() const noexcept
+    {
+        return ph_->version;
+    }
+
+    //--------------------------------------------
+    //
+    // Modifiers
+    //
+    //--------------------------------------------
+
+    /** Set the method of the request to the enum
+    */
+    void
+    set_method(
+        http_proto::method m)
+    {
+        set_impl(
+            m,
+            to_string(m),
+            target(),
+            version());
+    }
+
+    /** Set the method of the request to the string
+    */
+    void
+    set_method(
+        core::string_view s)
+    {
+        set_impl(
+            string_to_method(s),
+            s,
+            target(),
+            version());
+    }
+
+    /** Set the target string of the request
+
+        This function sets the request-target.
+        The caller is responsible for ensuring
+        that the string passed is syntactically
+        valid.
+    */
+    void
+    set_target(
+        core::string_view s)
+    {
+        set_impl(
+            ph_->req.method,
+            method_text(),
+            s,
+            version());
+    }
+
+    /** Set the HTTP version of the request
+    */
+    void
+    set_version(
+        http_proto::version v)
+    {
+        set_impl(
+            ph_->req.method,
+            method_text(),
+            target(),
+            v);
+    }
+
+    /** Set the method, target, and version of the request
+
+        This is more efficient than setting the
+        properties individually.
+    */
+    void
+    set_start_line(
+        http_proto::method m,
+        core::string_view t,
+        http_proto::version v)
+    {
+        set_impl(m, to_string(m), t, v);
+    }
+
+    /** Set the method, target, and version of the request
+
+        This is more efficient than setting the
+        properties individually.
+    */
+    void
+    set_start_line(
+        core::string_view m,
+        core::string_view t,
+        http_proto::version v)
+    {
+        set_impl(string_to_method(m), m, t, v);
+    }
+
+    /** Set the Expect header
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_expect_100_continue(bool b);
+
+private:
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_impl(
+        http_proto::method m,
+        core::string_view ms,
+        core::string_view t,
+        http_proto::version v);
+};
+
+} // http_proto
+} // boost
+
+#endif
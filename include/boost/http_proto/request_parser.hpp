@@ -49,9 +49,56 @@ public:
     BOOST_HTTP_PROTO_DECL
     request_view
     get() const;
+
+    /** Parse every complete request in the buffered input.
+
+        This parses requests from the committed
+        input, which may hold several pipelined
+        requests, without reading more. For each
+        complete request the handler is invoked
+        as if by:
+
+        @code
+        f( this->get(), this->body() );
+        @endcode
+
+        and @ref start is then called for the
+        next request. Requests are parsed in
+        place, in the buffer they were received
+        into; the views are invalidated when the
+        handler returns.
+
+        The function returns when the buffered
+        input holds no further complete request,
+        at the end of the stream, or on error.
+        Unless the stream ended, the parser is
+        then ready for more input to be committed
+        and this function to be called again. If
+        the header of a request was parsed but
+        its body is incomplete, the caller may
+        attach a body before reading more.
+
+        @par Preconditions
+        @ref start was called.
+
+        @return The number of requests passed
+        to the handler.
+
+        @param f The handler to invoke.
+
+        @param ec Set to the error, if any. More
+        input being needed is not an error.
+    */
+    template<class Handler>
+    std::size_t
+    parse_batch(
+        Handler&& f,
+        system::error_code& ec);
 };
 
 } // http_proto
 } // boost
 
+#include <boost/http_proto/impl/request_parser.hpp>
+
 #endif
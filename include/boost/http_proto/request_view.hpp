@@ -13,6 +13,8 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/message_view_base.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <boost/url/url_view.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -24,6 +26,7 @@ class BOOST_SYMBOL_VISIBLE
     : public message_view_base
 {
     friend class request;
+    friend class request_base;
     friend class request_parser;
 
     explicit
@@ -96,6 +99,36 @@ public:
             ph_->req.target_len);
     }
 
+    /** Return the request-target as a URL
+
+        The target is parsed as origin-form
+        when it begins with a slash, and as
+        absolute-form otherwise. The result
+        is kept alongside the request owned
+        by a parser or container, so that
+        later calls through any view of the
+        same request do not parse again,
+        until the target changes. Views of
+        one request may call this function
+        from several threads at once.
+
+        @par Example
+        @code
+        auto rv = pr.get().target_url();
+        if(rv && rv->path() == "/index.html")
+            handle_index(*rv);
+        @endcode
+
+        @return The URL, or an error if the
+        target is not valid in either form.
+
+        @see
+            @ref target_text.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<urls::url_view>
+    target_url() const noexcept;
+
     /** Return the HTTP-version
     */
     http_proto::version
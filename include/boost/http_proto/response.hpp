@@ -12,9 +12,10 @@
 #define BOOST_HTTP_PROTO_RESPONSE_HPP
 
 #include <boost/http_proto/detail/config.hpp>
-#include <boost/http_proto/message_base.hpp>
+#include <boost/http_proto/response_base.hpp>
 #include <boost/http_proto/response_view.hpp>
 #include <boost/http_proto/status.hpp>
+#include <boost/assert.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -23,7 +24,7 @@ namespace http_proto {
 */
 class BOOST_SYMBOL_VISIBLE
     response
-    : public message_base
+    : public response_base
 {
 public:
     /** Constructor
@@ -31,6 +32,40 @@ public:
     BOOST_HTTP_PROTO_DECL
     response() noexcept;
 
+    /** Constructor
+
+        Construct an empty response whose storage
+        is allocated from `mr`, such as an
+        arena released when the work using
+        the response is done. Nothing is
+        allocated until the response is modified.
+
+        A response move constructed from this
+        one uses the same memory resource.
+        Move assignment from a response using
+        another resource copies it, and both
+        must use the same resource to swap.
+        Copies of the response use the global
+        heap.
+
+        @par Example
+        @code
+        boost::container::pmr::monotonic_buffer_resource arena;
+        boost::http_proto::response res(arena);
+        res.set_start_line(
+            boost::http_proto::status::not_found);
+        @endcode
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the
+        resource must remain valid until the
+        storage is released.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    response(
+        container::pmr::memory_resource& mr) noexcept;
+
     /** Constructor
     */
     BOOST_HTTP_PROTO_DECL
@@ -149,7 +184,8 @@ public:
 
         The moved-from object will be
         left in the default-constructed
-        state.
+        state, with the same memory
+        resource.
     */
     BOOST_HTTP_PROTO_DECL
     response(response&& other) noexcept;
@@ -166,11 +202,15 @@ public:
         response_view const& other);
 
     /** Assignment
+
+        If the memory resources differ, the
+        contents are copied into storage from
+        this object's resource.
     */
     BOOST_HTTP_PROTO_DECL
     response&
     operator=(
-        response&& other) noexcept;
+        response&& other);
 
     /** Assignment
     */
@@ -210,107 +250,18 @@ public:
     response(
         http_proto::status sc);
 
-    /** Return a read-only view to the response
-    */
-    operator
-    response_view() const noexcept
-    {
-        return response_view(ph_);
-    }
-
-    //--------------------------------------------
-    //
-    // Observers
-    //
-    //--------------------------------------------
-
-    /** Return the reason string
-
-        This field is obsolete in HTTP/1
-        and should only be used for display
-        purposes.
-    */
-    core::string_view
-    reason() const noexcept
-    {
-        return core::string_view(
-            ph_->cbuf + 13,
-            ph_->prefix - 15);
-    }
-
-    /** Return the status code
-    */
-    http_proto::status
-    status() const noexcept
-    {
-        return ph_->res.status;
-    }
-
-    /** Return the status code
-    */
-    unsigned short
-    status_int() const noexcept
-    {
-        return ph_->res.status_int;
-    }
-
-    /** Return the HTTP version
-    */
-    http_proto::version
-    version() const noexcept
-    {
-        return ph_->version;
-    }
-
-    //--------------------------------------------
-    //
-    // Modifiers
-    //
-    //--------------------------------------------
-
-    /** Set the version, status code of the response
-
-        The reason phrase will be set to the
-        standard text for the specified status
-        code.
-
-        @par sc The status code. This must not be
-                @ref http_proto::status::unknown.
-
-        @par v The HTTP-version.
-    */
-    void
-    set_start_line(
-        http_proto::status sc,
-        http_proto::version v =
-            http_proto::version::http_1_1)
-    {
-        set_impl(
-            sc,
-            static_cast<
-                unsigned short>(sc),
-            obsolete_reason(sc),
-            v);
-    }
-
-    void
-    set_start_line(
-        unsigned short si,
-        core::string_view reason,
-        http_proto::version v)
-    {
-        set_impl(
-            int_to_status(si),
-            si,
-            reason,
-            v);
-    }
-
     /** Swap this with another instance
+
+        @par Preconditions
+        @code
+        this->resource() == other.resource()
+        @endcode
     */
     void
     swap(response& other) noexcept
     {
+        BOOST_ASSERT(
+            h_.mr == other.h_.mr);
         h_.swap(other.h_);
     }
 
@@ -325,15 +276,6 @@ public:
     {
         t0.swap(t1);
     }
-
-private:
-    BOOST_HTTP_PROTO_DECL
-    void
-    set_impl(
-        http_proto::status sc,
-        unsigned short si,
-        core::string_view reason,
-        http_proto::version v);
 };
 
 } // http_proto
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RESPONSE_TEMPLATE_HPP
+#define BOOST_HTTP_PROTO_RESPONSE_TEMPLATE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace boost {
+namespace http_proto {
+
+/** A response header with fields patched in place
+
+    A template is built once from a response.
+    Each registered slot reserves a fixed width
+    for the value of one field, and later values
+    are written over it without reparsing the
+    header or allocating. Unused width is filled
+    with spaces, which recipients discard as
+    trailing whitespace.
+
+    The serializer sends the header directly
+    from the template, so a value must not be
+    changed until the header has been sent.
+    Copies of a template are independent.
+
+    @par Example
+    @code
+    response res(status::ok);
+    res.set(field::server, "example");
+    res.set(field::content_type, "text/plain");
+    response_template tpl(res);
+
+    // for each response
+    tpl.set_content_length(body.size());
+    tpl.set(field::date, date);
+    sr.start(tpl, buffers::const_buffer(
+        body.data(), body.size()));
+    @endcode
+*/
+class BOOST_SYMBOL_VISIBLE
+    response_template
+{
+public:
+    /** A field whose value is replaced in place
+    */
+    struct slot
+    {
+        /// The field, which may not be unknown
+        field id;
+
+        /// The largest size of the value
+        std::size_t width;
+    };
+
+    /** The largest number of slots
+    */
+    static constexpr std::size_t max_slots = 8;
+
+    /** Constructor
+
+        The start line and fields of `res` are
+        copied, except for fields which have a
+        slot. The slots follow the other fields,
+        in the order given, each holding the
+        value from `res` if there is one.
+        A Content-Length slot with no value
+        starts at zero, and is left out when
+        `res` has a Transfer-Encoding.
+
+        @throws std::invalid_argument A slot
+        names an unknown field, a field other
+        than Content-Length which the metadata
+        tracks, such as Connection, or two
+        slots name the same field.
+
+        @throws std::length_error There are
+        more than @ref max_slots slots, or a
+        value from `res` does not fit its slot.
+
+        @param res The response to copy.
+
+        @param slots The fields to reserve.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    response_template(
+        response_view const& res,
+        std::initializer_list<slot> slots = {
+            { field::content_length, 20 },
+            { field::date, 29 } });
+
+    /** Return a read-only view to the response
+    */
+    operator
+    response_view() const noexcept
+    {
+        return res_;
+    }
+
+    /** Return the serialized header
+    */
+    core::string_view
+    buffer() const noexcept
+    {
+        return res_.buffer();
+    }
+
+    /** Set the value of a slot
+
+        @throws std::invalid_argument There is
+        no slot for `id`, `id` is Content-Length,
+        or `value` contains a CR, LF or other
+        control character.
+
+        @throws std::length_error The value
+        is larger than the slot.
+
+        @param id The field to set.
+
+        @param value The new value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set(
+        field id,
+        core::string_view value);
+
+    /** Set the value of the Content-Length slot
+
+        The payload of the response is updated
+        to match, so that a value of zero means
+        no payload.
+
+        @throws std::invalid_argument There is
+        no Content-Length slot.
+
+        @throws std::length_error The decimal
+        value is larger than the slot.
+
+        @param n The payload size.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_content_length(
+        std::uint64_t n);
+
+private:
+    struct slot_info
+    {
+        field id;
+        std::size_t width;
+        std::size_t index;  // in the table
+        std::size_t pos;    // of the value
+    };
+
+    slot_info*
+    find(field id) noexcept;
+
+    void
+    write(
+        slot_info const& s,
+        core::string_view value) noexcept;
+
+    response res_;
+    slot_info slots_[max_slots];
+    std::size_t n_ = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
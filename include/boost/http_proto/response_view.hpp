@@ -24,6 +24,7 @@ class BOOST_SYMBOL_VISIBLE
     : public message_view_base
 {
     friend class response;
+    friend class response_base;
     friend class response_parser;
 
     explicit
@@ -13,6 +13,8 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/rfc/parameter.hpp>
 #include <boost/url/grammar/range_rule.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -23,11 +25,11 @@ struct mime_type
 {
     /** The type
     */
-    string_view type;
+    core::string_view type;
 
     /** The subtype
     */
-    string_view subtype;
+    core::string_view subtype;
 };
 
 //------------------------------------------------
@@ -74,7 +76,7 @@ struct media_type_rule_t
     parse(
         char const*& it,
         char const* end) const noexcept ->
-            result<value_type>;
+            system::result<value_type>;
 };
 
 constexpr media_type_rule_t media_type_rule{};
@@ -11,6 +11,7 @@
 #define BOOST_HTTP_PROTO_SERIALIZER_HPP
 
 #include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file_body.hpp>
 #include <boost/http_proto/source.hpp>
 #include <boost/http_proto/detail/array_of_buffers.hpp>
 #include <boost/http_proto/detail/except.hpp>
@@ -29,11 +30,23 @@ namespace boost {
 namespace http_proto {
 
 #ifndef BOOST_HTTP_PROTO_DOCS
+class context;
+class fields_view;
+class filter;
 class request;
 class response;
 class request_view;
 class response_view;
 class message_view_base;
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+class mmap_body;
+#endif
+namespace zlib {
+struct deflate_encoder_service;
+} // zlib
+namespace brotli {
+struct encoder_service;
+} // brotli
 #endif
 
 /** A serializer for HTTP/1 messages
@@ -75,9 +88,40 @@ public:
     serializer(
         std::size_t buffer_size);
 
+    /** Constructor
+
+        Bodies from a source or a stream are
+        compressed when the message specifies
+        the deflate or gzip coding, in either
+        Content-Encoding or Transfer-Encoding,
+        and the encoder service is installed
+        in the context. The workspace is grown
+        to hold the encoder state.
+
+        When the context holds a workspace pool,
+        the workspace is borrowed from it only
+        while a message is in flight.
+
+        @see install_workspace_pool
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    serializer(
+        context& ctx);
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    serializer(
+        context& ctx,
+        std::size_t buffer_size);
+
     //--------------------------------------------
 
     /** Prepare the serializer for a new stream
+
+        Storage borrowed from a workspace pool
+        is returned.
     */
     BOOST_HTTP_PROTO_DECL
     void
@@ -127,6 +171,11 @@ public:
 
     /** Prepare the serializer for a new message
 
+        When `Source` is @ref mmap_body and no
+        content coding is applied, the buffers
+        returned by @ref prepare refer directly
+        to the mapped file.
+
         Changing the contents of the message
         after calling this function and before
         @ref is_done returns `true` results in
@@ -152,6 +201,78 @@ public:
     start_stream(
         message_view_base const& m);
 
+    /** Prepare the serializer for a new message
+
+        Data committed to the returned stream is
+        gathered until at least `threshold` bytes
+        are pending, @ref stream::flush is called,
+        or the stream is closed, before it becomes
+        output. For a chunked body each batch is
+        sent as a single chunk, so many small
+        commits do not each produce a chunk.
+
+        A threshold larger than the buffer can
+        hold is limited to the buffer. When a
+        content coding is applied the encoder
+        decides the chunks, and the threshold
+        has no effect.
+    */
+    BOOST_HTTP_PROTO_DECL
+    stream
+    start_stream(
+        message_view_base const& m,
+        std::size_t threshold);
+
+    //--------------------------------------------
+
+    /** Prepare the serializer for a new message
+
+        The body is not read through the
+        serializer. Instead, @ref prepare returns
+        the header and any chunk framing, and
+        fails with @ref error::need_file when the
+        next output is in the file. The caller
+        then transmits some of the region returned
+        by @ref file_data, for example using
+        `sendfile` or `splice`, and reports the
+        number of bytes sent to @ref consume_file.
+
+        Content codings are not applied to the
+        body. Changing the contents of the message
+        after calling this function and before
+        @ref is_done returns `true` results in
+        undefined behavior.
+
+        @throws system_error The position or
+        size of the file could not be determined.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    start_file(
+        message_view_base const& m,
+        file_body&& body);
+
+    /** Return the part of the file which is not yet sent
+
+        @par Preconditions
+        @ref prepare returned @ref error::need_file
+    */
+    file_body::region
+    file_data() const noexcept
+    {
+        return fr_;
+    }
+
+    /** Consume bytes sent from the file
+
+        @param n The number of bytes sent. This may
+        not exceed the size of the region returned
+        by @ref file_data.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    consume_file(std::uint64_t n);
+
     //--------------------------------------------
 
     /** Return true if serialization is complete.
@@ -229,17 +350,36 @@ private:
         return src;
     }
 
+    void set_done() noexcept;
     BOOST_HTTP_PROTO_DECL void start_init(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_empty(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_buffers(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_source(message_view_base const&, source*);
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    BOOST_HTTP_PROTO_DECL void start_source(message_view_base const&, mmap_body*);
+#endif
+    encoding body_encoding(message_view_base const&) const noexcept;
+    void init_filter(message_view_base const&);
+    void encode(system::error_code&);
+    void frame_chunks();
+
+    // the stream writes to tmp1_, and
+    // tmp0_ holds the framed output
+    bool
+    writes_tmp1() const noexcept
+    {
+        return filt_ || (
+            is_chunked_ && coalesce_ > 0);
+    }
 
     enum class style
     {
         empty,
         buffers,
         source,
-        stream
+        stream,
+        file,
+        mapped
     };
 
     // chunked-body   = *chunk
@@ -281,6 +421,11 @@ private:
     detail::workspace ws_;
     detail::array_of_const_buffers buf_;
     source* src_;
+    zlib::deflate_encoder_service const*
+        deflate_svc_ = nullptr;
+    brotli::encoder_service const*
+        brotli_svc_ = nullptr;
+    filter* filt_ = nullptr;
 
     buffers::circular_buffer tmp0_;
     buffers::circular_buffer tmp1_;
@@ -288,11 +433,37 @@ private:
 
     buffers::const_buffer* hp_;  // header
 
+    // the caller sends the file region
+    // before the last tail_ buffers of out_
+    file_body::region fr_ = {};
+    std::size_t tail_ = 0;
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    // out_ holds the mapped body
+    // in the buffer at mp_
+    mmap_body* mb_ = nullptr;
+    buffers::const_buffer* mp_ = nullptr;
+#endif
+
+    // stream data is gathered until
+    // this many bytes are pending
+    std::size_t coalesce_ = 0;
+
+    // width of the chunk header in
+    // front of the stream's buffers
+    std::size_t stream_header_len_ = 0;
+
+    // the trailer section, sent
+    // after the last-chunk
+    buffers::const_buffer tb_;
+
     style st_;
     bool more_;
     bool is_done_;
     bool is_chunked_;
     bool is_expect_continue_;
+    bool filter_done_;
+    bool flush_ = false;
 };
 
 //------------------------------------------------
@@ -335,10 +506,51 @@ struct serializer::stream
     void
     commit(std::size_t n) const;
 
+    /** Make all committed data available as output
+
+        When data is gathered, this sends what
+        is pending without waiting for the
+        threshold. Otherwise it has no effect.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    flush() const;
+
     BOOST_HTTP_PROTO_DECL
     void
     close() const;
 
+    /** Close the stream, sending trailer fields
+
+        The trailers are sent after the last
+        chunk of the body. Their buffer is not
+        copied, and must remain valid until
+        @ref serializer::is_done returns `true`.
+
+        Fields which frame, route, or modify the
+        message, such as Content-Length,
+        Transfer-Encoding, Host, or Trailer,
+        may not be sent in a trailer section.
+
+        @par Preconditions
+        The message uses the chunked transfer
+        coding, or `trailers` is empty.
+
+        @throws std::logic_error
+        The stream is closed, or the message
+        is not chunked.
+
+        @throws std::invalid_argument
+        `trailers` contains a field which is
+        not allowed in a trailer section.
+
+        @param trailers The fields to send.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    close(
+        fields_view const& trailers) const;
+
 private:
     friend class serializer;
 
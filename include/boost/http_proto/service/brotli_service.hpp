@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_BROTLI_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_BROTLI_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/filter.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/http_proto/detail/workspace.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace brotli {
+
+/*
+    Brotli Compressed Data Format
+    https://www.rfc-editor.org/rfc/rfc7932
+*/
+
+/** Configuration for the brotli decoder
+
+    Installing the decoder makes the workspace
+    of every parser in the context larger by
+    about twice the window, plus 3MiB for the
+    decoding tables, whether or not a message
+    is encoded. This is about 3.7MB for the
+    default window, and 11.5MB for a window
+    of 22 bits, which most encoders use by
+    default.
+*/
+struct decoder_config
+{
+    /** The base two logarithm of the largest window, from 10 to 24
+
+        Streams which use a larger window fail
+        to decode.
+    */
+    unsigned max_window_bits = 18;
+};
+
+//------------------------------------------------
+
+struct decoder_service
+    : service
+{
+    struct config : decoder_config
+    {
+        BOOST_HTTP_PROTO_BROTLI_DECL
+        void
+        install(context& ctx);
+    };
+
+    virtual
+    config const&
+    get_config() const noexcept = 0;
+
+    virtual
+    std::size_t
+    space_needed() const noexcept = 0;
+
+    virtual
+    filter&
+    make_filter(detail::workspace& ws) const = 0;
+};
+
+//------------------------------------------------
+
+/** Configuration for the brotli encoder
+
+    Installing the encoder makes the workspace
+    of every serializer in the context larger,
+    whether or not a body is encoded. The size
+    depends on the quality and window: about
+    3.5MB at the defaults, 8.6MB with a window
+    of 18 bits, and under 0.5MB at quality 0
+    or 1 with any window.
+*/
+struct encoder_config
+{
+    /** The compression quality, from 0 to 9
+
+        Qualities 10 and 11 are not supported,
+        because their memory use grows with the
+        input and cannot be reserved in the
+        workspace.
+    */
+    unsigned quality = 5;
+
+    /** The base two logarithm of the window size, from 10 to 24
+
+        At qualities 2 and up, the workspace
+        grows in proportion to the window.
+    */
+    unsigned window_bits = 16;
+};
+
+//------------------------------------------------
+
+struct encoder_service
+    : service
+{
+    struct config : encoder_config
+    {
+        BOOST_HTTP_PROTO_BROTLI_DECL
+        void
+        install(context& ctx);
+    };
+
+    virtual
+    config const&
+    get_config() const noexcept = 0;
+
+    virtual
+    std::size_t
+    space_needed() const noexcept = 0;
+
+    virtual
+    filter&
+    make_filter(detail::workspace& ws) const = 0;
+};
+
+//------------------------------------------------
+
+} // brotli
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_DATE_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_DATE_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** A service providing the value of the Date field
+
+    The current time is formatted as an
+    IMF-fixdate, for example
+    "Sun, 06 Nov 1994 08:49:37 GMT", and the
+    result is cached so that the string is
+    produced at most once per second.
+
+    Any number of threads may call @ref now
+    concurrently. Readers never block; when
+    the cached string is stale it is rebuilt
+    by whichever thread notices first.
+
+    The value may be assigned to a response
+    with `res.set(field::date, svc.now())`,
+    or written in place into a
+    @ref response_template with
+    `tpl.set(field::date, svc.now())`, which
+    does not rebuild the header.
+
+    @see
+        @ref install_date_service.
+*/
+class BOOST_SYMBOL_VISIBLE
+    date_service
+    : public service
+{
+public:
+    /** The size of an IMF-fixdate
+    */
+    static constexpr std::size_t date_size = 29;
+
+    /** A formatted date
+    */
+    class value_type
+    {
+        friend class date_service;
+
+        char buf_[date_size];
+
+    public:
+        /** Return the date as a string
+        */
+        core::string_view
+        str() const noexcept
+        {
+            return core::string_view(
+                buf_, date_size);
+        }
+
+        /** Return the date as a string
+        */
+        operator
+        core::string_view() const noexcept
+        {
+            return str();
+        }
+    };
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    date_service(context&) noexcept;
+
+    /** Return the current date
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    BOOST_HTTP_PROTO_DECL
+    value_type
+    now() const noexcept;
+
+    /** Return a time formatted as an IMF-fixdate
+
+        @param t The number of seconds since
+        the epoch, 1970-01-01 00:00:00 UTC.
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    value_type
+    format(std::int64_t t) noexcept;
+
+private:
+    static constexpr std::size_t words =
+        (date_size + 7) / 8;
+
+    // a sequence lock guards the cached
+    // string, which is held in atomic
+    // words so that torn reads are
+    // detected rather than undefined
+    mutable std::atomic<std::uint32_t> seq_;
+    mutable std::atomic<std::int64_t> t_;
+    mutable std::atomic<std::uint64_t> w_[words];
+};
+
+//------------------------------------------------
+
+/** Install the date service
+
+    @return A reference to the service.
+
+    @throw std::invalid_argument The
+    service already exists.
+*/
+BOOST_HTTP_PROTO_DECL
+date_service&
+install_date_service(
+    context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,618 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_IMPL_BROTLI_SERVICE_IPP
+#define BOOST_HTTP_PROTO_SERVICE_IMPL_BROTLI_SERVICE_IPP
+
+#include <boost/http_proto/service/brotli_service.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <boost/system/error_code.hpp>
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+namespace brotli {
+namespace detail {
+
+/*
+    Brotli Compressed Data Format
+    https://www.rfc-editor.org/rfc/rfc7932
+*/
+
+//------------------------------------------------
+
+// Negative values are BrotliDecoderErrorCode
+enum class error
+{
+    encoder_failed = 1
+};
+
+//------------------------------------------------
+} // detail
+} // brotli
+} // http_proto
+namespace system {
+template<>
+struct is_error_code_enum<
+    ::boost::http_proto::brotli::detail::error>
+{
+    static bool const value = true;
+};
+} // system
+namespace http_proto {
+namespace brotli {
+namespace detail {
+//------------------------------------------------
+
+struct error_cat_type
+    : system::error_category
+{
+    BOOST_SYSTEM_CONSTEXPR
+    error_cat_type() noexcept
+        : error_category(
+            0xa52f1ba3c6f9e210)
+    {
+    }
+
+    const char*
+    name() const noexcept override
+    {
+        return "boost.http.proto.brotli";
+    }
+
+    std::string
+    message( int ev ) const override
+    {
+        return message( ev, nullptr, 0 );
+    }
+
+    char const*
+    message(
+        int ev,
+        char*,
+        std::size_t) const noexcept override
+    {
+        if(ev == static_cast<int>(
+                error::encoder_failed))
+            return "encoder failed";
+        return BrotliDecoderErrorString(
+            static_cast<BrotliDecoderErrorCode>(ev));
+    }
+};
+
+system::error_code
+make_error_code(
+    error ev) noexcept
+{
+    static BOOST_SYSTEM_CONSTEXPR
+        error_cat_type cat{};
+    return system::error_code{static_cast<
+        std::underlying_type<
+            error>::type>(ev), cat};
+}
+
+//------------------------------------------------
+
+/*  Base for filters which use brotli.
+
+    All of the memory used by brotli is carved
+    out of a single block acquired from the
+    workspace at construction. Unlike zlib,
+    brotli frees and reallocates as a stream
+    progresses, so the block is managed as a
+    free list sorted by address, and adjacent
+    chunks are coalesced when released. When
+    a request does not fit, brotli reports an
+    allocation error; the heap is never used.
+*/
+class brotli_filter
+    : public filter
+{
+    struct chunk
+    {
+        std::size_t size;
+        chunk* next;
+    };
+
+public:
+    // overhead of each allocation
+    // carved out of the block
+    static constexpr std::size_t slack =
+        alignof(::max_align_t);
+
+    // the header in front of each allocation
+    static constexpr std::size_t header =
+        (sizeof(chunk) + slack - 1) & ~(slack - 1);
+
+protected:
+    brotli_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size)
+    {
+        auto const p = ws.push_array(
+            block_size,
+            static_cast<unsigned char>(0));
+        auto const pad = (slack -
+            reinterpret_cast<std::uintptr_t>(
+                p) % slack) % slack;
+        free_ = reinterpret_cast<
+            chunk*>(p + pad);
+        free_->size =
+            (block_size - pad) & ~(slack - 1);
+        free_->next = nullptr;
+    }
+
+    static
+    void*
+    alloc(
+        void* opaque,
+        std::size_t n) noexcept
+    {
+        auto& self = *static_cast<
+            brotli_filter*>(opaque);
+        if(n > std::size_t(-1) -
+                header - slack)
+            return nullptr;
+        n = header +
+            ((n + slack - 1) & ~(slack - 1));
+        // first fit
+        for(auto pp = &self.free_;
+            *pp; pp = &(*pp)->next)
+        {
+            auto const c = *pp;
+            if(c->size < n)
+                continue;
+            if(c->size - n >= header + slack)
+            {
+                // split, keeping the rest free
+                auto const r =
+                    reinterpret_cast<chunk*>(
+                        reinterpret_cast<
+                            unsigned char*>(c) + n);
+                r->size = c->size - n;
+                r->next = c->next;
+                *pp = r;
+                c->size = n;
+            }
+            else
+            {
+                *pp = c->next;
+            }
+            return reinterpret_cast<
+                unsigned char*>(c) + header;
+        }
+        return nullptr;
+    }
+
+    static
+    void
+    free(
+        void* opaque,
+        void* p) noexcept
+    {
+        if(! p)
+            return;
+        auto& self = *static_cast<
+            brotli_filter*>(opaque);
+        auto const c = reinterpret_cast<
+            chunk*>(static_cast<
+                unsigned char*>(p) - header);
+        chunk* prev = nullptr;
+        auto pp = &self.free_;
+        while(*pp && *pp < c)
+        {
+            prev = *pp;
+            pp = &(*pp)->next;
+        }
+        c->next = *pp;
+        *pp = c;
+        if( c->next && end(c) ==
+            reinterpret_cast<
+                unsigned char*>(c->next))
+        {
+            c->size += c->next->size;
+            c->next = c->next->next;
+        }
+        if( prev && end(prev) ==
+            reinterpret_cast<
+                unsigned char*>(c))
+        {
+            prev->size += c->size;
+            prev->next = c->next;
+        }
+    }
+
+private:
+    static
+    unsigned char*
+    end(chunk* c) noexcept
+    {
+        return reinterpret_cast<
+            unsigned char*>(c) + c->size;
+    }
+
+    chunk* free_;
+};
+
+//------------------------------------------------
+
+class decoder_filter
+    : public brotli_filter
+{
+public:
+    // the state, the ring buffer and the
+    // previous one while it grows, the
+    // context maps, and the tree groups
+    static constexpr std::size_t allocations = 16;
+
+    decoder_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size)
+        : brotli_filter(ws, block_size)
+        , st_(BrotliDecoderCreateInstance(
+            &alloc, &free, this))
+    {
+        if(! st_)
+            http_proto::detail::throw_bad_alloc();
+        BrotliDecoderSetParameter(st_,
+            BROTLI_DECODER_PARAM_LARGE_WINDOW, 0);
+    }
+
+    ~decoder_filter()
+    {
+        BrotliDecoderDestroyInstance(st_);
+    }
+
+    // An upper bound on the memory used to
+    // decode a stream whose window is at most
+    // 2^window_bits: the ring buffer, which
+    // coexists with its predecessor while it
+    // grows and may not reuse its space, and
+    // the tables of one metablock, which
+    // never exceed 3MiB.
+    static
+    std::size_t
+    block_size(
+        unsigned window_bits) noexcept
+    {
+        std::size_t const ring =
+            (std::size_t(1) << window_bits) +
+            1024;
+        return 2 * ring +
+            (std::size_t(3) << 20) +
+            allocations * (header + slack);
+    }
+
+private:
+    results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override
+    {
+        results rv;
+        (void)more;
+        std::size_t n0 = in.size();
+        std::size_t n1 = out.size();
+        auto p0 = static_cast<
+            std::uint8_t const*>(in.data());
+        auto p1 = static_cast<
+            std::uint8_t*>(out.data());
+        auto const r =
+            BrotliDecoderDecompressStream(
+                st_, &n0, &p0, &n1, &p1, nullptr);
+        rv.in_bytes = in.size() - n0;
+        rv.out_bytes = out.size() - n1;
+        switch(r)
+        {
+        case BROTLI_DECODER_RESULT_SUCCESS:
+            rv.finished = true;
+            break;
+
+        case BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT:
+        case BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT:
+            break;
+
+        default:
+        case BROTLI_DECODER_RESULT_ERROR:
+            rv.ec = static_cast<error>(
+                BrotliDecoderGetErrorCode(st_));
+            break;
+        }
+        return rv;
+    }
+
+    BrotliDecoderState* st_;
+};
+
+//------------------------------------------------
+
+class encoder_filter
+    : public brotli_filter
+{
+public:
+    // the state, the ring buffer, the hash
+    // tables, and the command, literal,
+    // and output buffers as they grow
+    static constexpr std::size_t allocations = 32;
+
+    encoder_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size,
+        std::uint32_t quality,
+        std::uint32_t window_bits)
+        : brotli_filter(ws, block_size)
+        , st_(BrotliEncoderCreateInstance(
+            &alloc, &free, this))
+    {
+        if(! st_)
+            http_proto::detail::throw_bad_alloc();
+        BrotliEncoderSetParameter(st_,
+            BROTLI_PARAM_QUALITY, quality);
+        BrotliEncoderSetParameter(st_,
+            BROTLI_PARAM_LGWIN, window_bits);
+        BrotliEncoderSetParameter(st_,
+            BROTLI_PARAM_LARGE_WINDOW, 0);
+    }
+
+    ~encoder_filter()
+    {
+        BrotliEncoderDestroyInstance(st_);
+    }
+
+    // the highest quality whose
+    // memory use has an upper bound
+    static constexpr unsigned max_quality = 9;
+
+    // the most input given to brotli in
+    // one call, which the bound covers
+    static constexpr std::size_t max_input = 32768;
+
+    // An upper bound on the memory used to
+    // encode at a quality and window. Brotli
+    // has no way to ask, and its encoder
+    // exits the process when an allocation
+    // fails, so this must never be exceeded.
+    // Each quality has a fixed part for its
+    // hash tables and metablock buffers,
+    // which are larger above 64KiB windows,
+    // and a part proportional to the window
+    // for the ring buffer. The metablocks of
+    // qualities 2 and up hold 64KiB or more
+    // whatever the window, and qualities 0
+    // and 1 size their scratch buffers by
+    // the input of each call, up to
+    // max_input. These were measured in this
+    // allocator against several kinds of
+    // input many times larger than both, and
+    // then given a quarter more. Qualities 10
+    // and 11 use memory which grows with the
+    // input, so they have no bound.
+    static
+    std::size_t
+    block_size(
+        unsigned quality,
+        unsigned window_bits) noexcept
+    {
+        // KiB up to and above 64KiB windows,
+        // and eighths of the window
+        static constexpr std::size_t tab[][3] = {
+            {  208,   208,   0 }, {  368,   368,   0 },
+            { 1056,  1056,  48 }, {  848,   944,  48 },
+            { 1872,  2496, 113 }, { 1856,  3104, 113 },
+            { 1856,  4048, 111 }, { 1856, 10048, 113 },
+            { 1856, 18720, 111 }, { 2624, 34688, 115 } };
+        BOOST_ASSERT(quality <= max_quality);
+        auto const& t = tab[quality];
+        std::size_t const n =
+            t[window_bits > 16] * 1024 +
+            ((t[2] << window_bits) / 8);
+        return n + n / 4 +
+            allocations * (header + slack);
+    }
+
+private:
+    results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override
+    {
+        results rv;
+        std::size_t n0 = in.size();
+        std::size_t n1 = out.size();
+        auto p0 = static_cast<
+            std::uint8_t const*>(in.data());
+        auto p1 = static_cast<
+            std::uint8_t*>(out.data());
+        for(;;)
+        {
+            // the input of each call is capped,
+            // since the fast qualities size their
+            // scratch buffers and hash table by it
+            std::size_t const n =
+                n0 < max_input ? n0 : max_input;
+            bool const last = ! more && n == n0;
+            std::size_t a = n;
+            // BROTLI_OPERATION_FINISH may be repeated
+            // until all of the output is delivered.
+            if(! BrotliEncoderCompressStream(
+                st_,
+                last ?
+                    BROTLI_OPERATION_FINISH :
+                    BROTLI_OPERATION_PROCESS,
+                &a, &p0, &n1, &p1, nullptr))
+            {
+                rv.ec = error::encoder_failed;
+                return rv;
+            }
+            n0 -= n - a;
+            if( last || a > 0 ||
+                n0 == 0 || n1 == 0)
+                break;
+        }
+        rv.in_bytes = in.size() - n0;
+        rv.out_bytes = out.size() - n1;
+        rv.finished =
+            BrotliEncoderIsFinished(st_) != 0;
+        return rv;
+    }
+
+    BrotliEncoderState* st_;
+};
+
+//------------------------------------------------
+
+struct
+    decoder_service_impl
+    : decoder_service
+{
+    using key_type =
+        decoder_service;
+
+    explicit
+    decoder_service_impl(
+        context& ctx,
+        config const& cfg)
+        : cfg_(cfg)
+    {
+        (void)ctx;
+        if( cfg_.max_window_bits < BROTLI_MIN_WINDOW_BITS ||
+            cfg_.max_window_bits > BROTLI_MAX_WINDOW_BITS)
+            http_proto::detail::throw_invalid_argument();
+
+        block_size_ = decoder_filter::block_size(
+            cfg_.max_window_bits);
+
+        // the filter, the block, and the
+        // header and padding of the block
+        space_needed_ =
+            http_proto::detail::workspace::
+                space_needed<decoder_filter>() +
+            block_size_ +
+            4 * alignof(::max_align_t);
+    }
+
+private:
+    config cfg_;
+    std::size_t block_size_ = 0;
+    std::size_t space_needed_ = 0;
+
+    config const&
+    get_config() const noexcept override
+    {
+        return cfg_;
+    }
+
+    std::size_t
+    space_needed() const noexcept override
+    {
+        return space_needed_;
+    }
+
+    filter&
+    make_filter(http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<decoder_filter>(
+            ws, block_size_);
+    }
+};
+
+//------------------------------------------------
+
+struct
+    encoder_service_impl
+    : encoder_service
+{
+    using key_type =
+        encoder_service;
+
+    explicit
+    encoder_service_impl(
+        context& ctx,
+        config const& cfg)
+        : cfg_(cfg)
+    {
+        (void)ctx;
+        // qualities above the bound would
+        // need memory outside the workspace
+        if( cfg_.quality > encoder_filter::max_quality ||
+            cfg_.window_bits < BROTLI_MIN_WINDOW_BITS ||
+            cfg_.window_bits > BROTLI_MAX_WINDOW_BITS)
+            http_proto::detail::throw_invalid_argument();
+
+        block_size_ = encoder_filter::block_size(
+            cfg_.quality, cfg_.window_bits);
+
+        // the filter, the block, and the
+        // header and padding of the block
+        space_needed_ =
+            http_proto::detail::workspace::
+                space_needed<encoder_filter>() +
+            block_size_ +
+            4 * alignof(::max_align_t);
+    }
+
+private:
+    config cfg_;
+    std::size_t block_size_ = 0;
+    std::size_t space_needed_ = 0;
+
+    config const&
+    get_config() const noexcept override
+    {
+        return cfg_;
+    }
+
+    std::size_t
+    space_needed() const noexcept override
+    {
+        return space_needed_;
+    }
+
+    filter&
+    make_filter(http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<encoder_filter>(
+            ws,
+            block_size_,
+            cfg_.quality,
+            cfg_.window_bits);
+    }
+};
+
+} // detail
+
+void
+decoder_service::
+config::
+install(context& ctx)
+{
+    ctx.make_service<
+        detail::decoder_service_impl>(*this);
+}
+
+void
+encoder_service::
+config::
+install(context& ctx)
+{
+    ctx.make_service<
+        detail::encoder_service_impl>(*this);
+}
+
+} // brotli
+} // http_proto
+} // boost
+
+#endif
@@ -52,6 +52,48 @@ struct deflate_decoder_service
 
 //------------------------------------------------
 
+struct encoder_config
+{
+    unsigned level = 6;
+    unsigned window_bits = 15;
+    unsigned mem_level = 8;
+};
+
+//------------------------------------------------
+
+struct deflate_encoder_service
+    : service
+{
+    struct config : encoder_config
+    {
+        BOOST_HTTP_PROTO_ZLIB_DECL
+        void
+        install(context& ctx);
+    };
+
+    virtual
+    config const&
+    get_config() const noexcept = 0;
+
+    virtual
+    std::size_t
+    space_needed() const noexcept = 0;
+
+    /** Return a new encoder in the workspace
+
+        @param gzip If `true` the output uses the
+            gzip format, else the zlib format
+            which is the "deflate" coding.
+    */
+    virtual
+    filter&
+    make_filter(
+        detail::workspace& ws,
+        bool gzip) const = 0;
+};
+
+//------------------------------------------------
+
 } // zlib
 } // http_proto
 } // boost
@@ -17,10 +17,10 @@ in a translation unit of the program.
 
 */
 
-#ifndef BOOST_HTTP_PROTO_EXT_SOURCE
-#define BOOST_HTTP_PROTO_EXT_SOURCE
+#ifndef BOOST_HTTP_PROTO_BROTLI_SOURCE
+#define BOOST_HTTP_PROTO_BROTLI_SOURCE
 #endif
 
-//#include <boost/http_proto/detail/impl/brotli_codec.ipp>
+#include <boost/http_proto/service/impl/brotli_service.ipp>
 
 #endif
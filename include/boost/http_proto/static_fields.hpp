@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_FIELDS_HPP
+#define BOOST_HTTP_PROTO_STATIC_FIELDS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_base.hpp>
+#include <boost/http_proto/fields_view.hpp>
+#include <boost/http_proto/detail/static_storage.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable container of HTTP fields with inline storage
+
+    The fields and their index are stored
+    in a buffer of `Capacity` bytes inside
+    the object, so that short-lived
+    containers need not allocate. When
+    the fields outgrow the buffer, they
+    move to the global heap, and move back
+    on @ref shrink_to_fit once they fit.
+
+    The object cannot be moved or swapped
+    with other containers, since the
+    storage is part of the object. Copies
+    copy the fields.
+
+    @tparam Capacity The size of the inline
+    storage in bytes, which includes the
+    index of the fields.
+
+    @see
+        @ref fields.
+*/
+template<std::size_t Capacity>
+class static_fields
+    : private detail::static_storage<Capacity>
+    , public fields_base
+{
+    using storage =
+        detail::static_storage<Capacity>;
+
+public:
+    /** Constructor
+
+        Default-constructed fields have no
+        name-value pairs.
+    */
+    static_fields()
+        : fields_view_base(
+            &this->fields_base::h_)
+        , fields_base(
+            detail::kind::fields,
+            &this->inline_mr_)
+    {
+        reallocate(storage::inline_size);
+    }
+
+    /** Constructor
+    */
+    static_fields(
+        static_fields const& other)
+        : static_fields()
+    {
+        *this = other;
+    }
+
+    /** Constructor
+    */
+    explicit
+    static_fields(
+        fields_view const& other)
+        : static_fields()
+    {
+        *this = other;
+    }
+
+    /** Assignment
+    */
+    static_fields&
+    operator=(
+        static_fields const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Assignment
+    */
+    static_fields&
+    operator=(
+        fields_view const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Conversion
+    */
+    operator fields_view() const noexcept
+    {
+        return fields_view(ph_);
+    }
+
+    /** Remove excess capacity
+
+        If the fields are on the heap and
+        fit in the inline storage, they are
+        moved back into it.
+    */
+    void
+    shrink_to_fit()
+    {
+        reallocate(storage::inline_size);
+        if(h_.buf != this->inline_buf_)
+            fields_base::shrink_to_fit();
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
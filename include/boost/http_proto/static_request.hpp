@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_REQUEST_HPP
+#define BOOST_HTTP_PROTO_STATIC_REQUEST_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/request_base.hpp>
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/detail/static_storage.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable HTTP request with inline storage
+
+    The start-line, the fields and their
+    index are stored in a buffer of
+    `Capacity` bytes inside the object, so
+    that short-lived requests need not
+    allocate. When the request outgrows
+    the buffer, it moves to the global
+    heap, and moves back on
+    @ref shrink_to_fit once it fits.
+
+    The object cannot be moved or swapped
+    with a @ref request, since the storage
+    is part of the object. Copies copy the
+    request.
+
+    @tparam Capacity The size of the inline
+    storage in bytes, which includes the
+    index of the fields.
+
+    @see
+        @ref request.
+*/
+template<std::size_t Capacity>
+class static_request
+    : private detail::static_storage<Capacity>
+    , public request_base
+{
+    using storage =
+        detail::static_storage<Capacity>;
+
+public:
+    /** Constructor
+
+        A default-constructed request contains
+        the start-line "GET / HTTP/1.1"
+        and no fields.
+    */
+    static_request()
+        : fields_view_base(
+            &this->fields_base::h_)
+        , request_base(this->inline_mr_)
+    {
+        reallocate(storage::inline_size);
+    }
+
+    /** Constructor
+    */
+    static_request(
+        static_request const& other)
+        : static_request()
+    {
+        *this = other;
+    }
+
+    /** Constructor
+    */
+    explicit
+    static_request(
+        request_view const& other)
+        : static_request()
+    {
+        *this = other;
+    }
+
+    /** Assignment
+    */
+    static_request&
+    operator=(
+        static_request const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Assignment
+    */
+    static_request&
+    operator=(
+        request_view const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Remove excess capacity
+
+        If the request is on the heap and
+        fits in the inline storage, it is
+        moved back into it.
+    */
+    void
+    shrink_to_fit()
+    {
+        reallocate(storage::inline_size);
+        if(h_.buf != this->inline_buf_)
+            fields_base::shrink_to_fit();
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_RESPONSE_HPP
+#define BOOST_HTTP_PROTO_STATIC_RESPONSE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/response_base.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/http_proto/detail/static_storage.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable HTTP response with inline storage
+
+    The start-line, the fields and their
+    index are stored in a buffer of
+    `Capacity` bytes inside the object, so
+    that short-lived responses need not
+    allocate. When the response outgrows
+    the buffer, it moves to the global
+    heap, and moves back on
+    @ref shrink_to_fit once it fits.
+
+    The object cannot be moved or swapped
+    with a @ref response, since the storage
+    is part of the object. Copies copy the
+    response.
+
+    @tparam Capacity The size of the inline
+    storage in bytes, which includes the
+    index of the fields.
+
+    @see
+        @ref response.
+*/
+template<std::size_t Capacity>
+class static_response
+    : private detail::static_storage<Capacity>
+    , public response_base
+{
+    using storage =
+        detail::static_storage<Capacity>;
+
+public:
+    /** Constructor
+
+        A default-constructed response contains
+        the start-line "HTTP/1.1 200 OK"
+        and no fields.
+    */
+    static_response()
+        : fields_view_base(
+            &this->fields_base::h_)
+        , response_base(this->inline_mr_)
+    {
+        reallocate(storage::inline_size);
+    }
+
+    /** Constructor
+    */
+    static_response(
+        static_response const& other)
+        : static_response()
+    {
+        *this = other;
+    }
+
+    /** Constructor
+    */
+    explicit
+    static_response(
+        response_view const& other)
+        : static_response()
+    {
+        *this = other;
+    }
+
+    /** Assignment
+    */
+    static_response&
+    operator=(
+        static_response const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Assignment
+    */
+    static_response&
+    operator=(
+        response_view const& other)
+    {
+        copy_impl(*other.ph_);
+        reallocate(storage::inline_size);
+        return *this;
+    }
+
+    /** Remove excess capacity
+
+        If the response is on the heap and
+        fits in the inline storage, it is
+        moved back into it.
+    */
+    void
+    shrink_to_fit()
+    {
+        reallocate(storage::inline_size);
+        if(h_.buf != this->inline_buf_)
+            fields_base::shrink_to_fit();
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
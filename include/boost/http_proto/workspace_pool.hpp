@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_WORKSPACE_POOL_HPP
+#define BOOST_HTTP_PROTO_WORKSPACE_POOL_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+#ifndef BOOST_HTTP_PROTO_DOCS
+class context;
+#endif
+
+/** Install a pool of workspace storage
+
+    Parsers and serializers constructed with a
+    context holding the pool do not keep their
+    storage between messages. Instead, they
+    borrow it from the pool while a message is
+    in flight:
+
+    @li A parser returns its storage when
+    @ref parser::reset is called, and when
+    @ref parser::start is called with no
+    pipelined data left over from the previous
+    message. The storage is borrowed again by
+    the next call to @ref parser::prepare or
+    @ref parser::parse.
+
+    @li A serializer borrows storage when a
+    message is started and returns it when
+    @ref serializer::is_done becomes `true`,
+    destroying any source or buffers placed in
+    it, or when @ref serializer::reset is called.
+
+    An idle keep-alive connection which waits
+    for the socket to become readable before
+    calling @ref parser::prepare then holds no
+    storage at all. The pool is lock-free and
+    may be used from any number of threads.
+
+    @param ctx The context to install into.
+
+    @param max_idle The largest number of
+    unused blocks of storage kept by the pool.
+    Storage returned to a full pool is freed.
+
+    @throws std::invalid_argument The pool
+    already exists.
+*/
+BOOST_HTTP_PROTO_DECL
+void
+install_workspace_pool(
+    context& ctx,
+    std::size_t max_idle = 64);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/byteranges_source.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <cstring>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+void
+append_number(
+    std::string& s,
+    std::uint64_t n)
+{
+    char buf[20];
+    auto const end = buf + sizeof(buf);
+    auto p = end;
+    do
+    {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    }
+    while(n > 0);
+    s.append(p, end);
+}
+
+} // (anon)
+
+byteranges_source::
+~byteranges_source() = default;
+
+byteranges_source::
+byteranges_source(
+    byteranges_source&&) noexcept = default;
+
+byteranges_source::
+byteranges_source(
+    file&& f,
+    std::uint64_t size,
+    std::vector<range> ranges,
+    core::string_view content_type,
+    core::string_view boundary)
+    : f_(std::move(f))
+    , size_(size)
+    , ranges_(std::move(ranges))
+    , type_(content_type)
+    , boundary_(boundary)
+{
+    // rfc2046 section 5.1.1
+    if( boundary_.empty() ||
+        boundary_.size() > 70)
+        detail::throw_invalid_argument();
+    if(ranges_.empty())
+        detail::throw_invalid_argument();
+    for(auto const& r : ranges_)
+        if( r.first > r.last ||
+            r.last >= size_)
+            detail::throw_invalid_argument();
+
+    for(std::size_t i = 0;
+        i <= ranges_.size(); ++i)
+    {
+        format(i);
+        length_ += head_.size() + left_;
+    }
+    format(0);
+}
+
+// Sets head_ to the text preceding
+// part i, or the close delimiter.
+//
+//  --boundary CRLF
+//  Content-Type: type CRLF
+//  Content-Range: bytes first-last/size CRLF
+//  CRLF
+//  data CRLF
+//  --boundary--
+void
+byteranges_source::
+format(std::size_t i)
+{
+    head_.clear();
+    pos_ = 0;
+    left_ = 0;
+    if(i > 0)
+        head_.append("\r\n");
+    head_.append("--");
+    head_.append(boundary_);
+    if(i == ranges_.size())
+    {
+        head_.append("--\r\n");
+        return;
+    }
+    head_.append("\r\n");
+    if(! type_.empty())
+    {
+        head_.append("Content-Type: ");
+        head_.append(type_);
+        head_.append("\r\n");
+    }
+    auto const& r = ranges_[i];
+    head_.append("Content-Range: bytes ");
+    append_number(head_, r.first);
+    head_.push_back('-');
+    append_number(head_, r.last);
+    head_.push_back('/');
+    append_number(head_, size_);
+    head_.append("\r\n\r\n");
+    left_ = r.last - r.first + 1;
+    seek_ = true;
+}
+
+auto
+byteranges_source::
+on_read(
+    buffers::mutable_buffer b) ->
+        results
+{
+    results rv;
+    auto p = static_cast<char*>(b.data());
+    auto n = b.size();
+    while(n > 0)
+    {
+        if(pos_ < head_.size())
+        {
+            auto k = head_.size() - pos_;
+            if( k > n)
+                k = n;
+            std::memcpy(p, head_.data() + pos_, k);
+            pos_ += k;
+            p += k;
+            n -= k;
+            rv.bytes += k;
+            continue;
+        }
+        if(i_ == ranges_.size())
+            break;
+
+        if(seek_)
+        {
+            f_.seek(ranges_[i_].first, rv.ec);
+            if(rv.ec.failed())
+                return rv;
+            seek_ = false;
+        }
+        std::size_t k;
+        if( left_ >= n)
+            k = n;
+        else
+            k = static_cast<std::size_t>(left_);
+        k = f_.read(p, k, rv.ec);
+        if(rv.ec.failed())
+            return rv;
+        if(k == 0)
+        {
+            // the file is shorter
+            // than the range
+            rv.ec = BOOST_HTTP_PROTO_ERR(
+                error::incomplete);
+            return rv;
+        }
+        p += k;
+        n -= k;
+        rv.bytes += k;
+        left_ -= k;
+        if(left_ == 0)
+            format(++i_);
+    }
+    rv.finished =
+        i_ == ranges_.size() &&
+        pos_ == head_.size();
+    return rv;
+}
+
+} // http_proto
+} // boost
@@ -10,7 +10,10 @@
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/detail/except.hpp>
 //#include <boost/unordered_map.hpp> // doesn't support heterogenous lookup yet
+#include <atomic>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace http_proto {
@@ -23,10 +26,36 @@ struct context::data
         std::unique_ptr<service>,
         detail::type_index_hasher
             > services;
+
+    // The slot of each service, in
+    // the order they were installed
+    std::vector<std::pair<
+        detail::type_index,
+        std::size_t>> order;
+
+    // Built by freeze()
+    std::vector<service*> slots;
+    std::vector<std::pair<
+        detail::type_index,
+        service*>> flat;
 };
 
 //------------------------------------------------
 
+namespace detail {
+
+std::size_t
+next_service_slot() noexcept
+{
+    static std::atomic<std::size_t> n{0};
+    return n.fetch_add(1,
+        std::memory_order_relaxed);
+}
+
+} // detail
+
+//------------------------------------------------
+
 context::
 ~context()
 {
@@ -46,6 +75,15 @@ find_service_impl(
     detail::type_index id) const noexcept ->
         service*
 {
+    if(frozen_)
+    {
+        // not found by slot; the
+        // list is short so scan it
+        for(auto const& e : p_->flat)
+            if(e.first == id)
+                return e.second;
+        return nullptr;
+    }
     auto it = p_->services.find(id);
     if(it != p_->services.end())
         return it->second.get();
@@ -56,9 +94,12 @@ auto
 context::
 make_service_impl(
     detail::type_index id,
+    std::size_t slot,
     std::unique_ptr<service> sp) ->
         service&
 {
+    p_->order.reserve(
+        p_->order.size() + 1);
     auto const result =
         p_->services.emplace(
             id, std::move(sp));
@@ -67,8 +108,34 @@ make_service_impl(
         // already exists
         detail::throw_out_of_range();
     }
+    p_->order.emplace_back(id, slot);
     return *result.first->second;
 }
 
+void
+context::
+freeze()
+{
+    if(frozen_)
+        return;
+    auto& d = *p_;
+    std::size_t n = 0;
+    for(auto const& e : d.order)
+        if(n <= e.second)
+            n = e.second + 1;
+    d.slots.assign(n, nullptr);
+    d.flat.reserve(d.order.size());
+    for(auto const& e : d.order)
+    {
+        auto const ps =
+            d.services.find(e.first)->second.get();
+        d.slots[e.second] = ps;
+        d.flat.emplace_back(e.first, ps);
+    }
+    slots_ = d.slots.data();
+    n_slots_ = n;
+    frozen_ = true;
+}
+
 } // http_proto
 } // boost
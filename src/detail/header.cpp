@@ -7,8 +7,11 @@
 // Official repository: https://github.com/cppalliance/http_proto
 //
 
+#include "simd.hpp"
+
 #include <boost/http_proto/detail/header.hpp>
 #include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/target_cache.hpp>
 #include <boost/http_proto/field.hpp>
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/http_proto/header_limits.hpp>
@@ -22,10 +25,12 @@
 #include <boost/url/grammar/range_rule.hpp>
 #include <boost/url/grammar/recycled.hpp>
 #include <boost/url/grammar/unsigned_rule.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
 #include <boost/assert.hpp>
 #include <boost/assert/source_location.hpp>
 #include <boost/static_assert.hpp>
 #include <string>
+#include <thread>
 #include <utility>
 
 namespace boost {
@@ -137,11 +142,20 @@ swap(header& h) noexcept
     std::swap(buf, h.buf);
     std::swap(cap, h.cap);
     std::swap(max_cap, h.max_cap);
+    std::swap(mr, h.mr);
+    // tc stays with its owner, and
+    // the buffers it refers to move
+    if(tc)
+        tc->clear();
+    if(h.tc)
+        h.tc->clear();
     std::swap(size, h.size);
     std::swap(count, h.count);
     std::swap(prefix, h.prefix);
     std::swap(version, h.version);
     std::swap(md, h.md);
+    std::swap(ids, h.ids);
+    std::swap(lazy, h.lazy);
     switch(kind)
     {
     default:
@@ -264,6 +278,8 @@ header::
 find(
     field id) const noexcept
 {
+    if(! ids.contains(id))
+        return count;
     if(count == 0)
         return 0;
     std::size_t i = 0;
@@ -283,6 +299,15 @@ header::
 find(
     core::string_view name) const noexcept
 {
+    // known names are always stored with
+    // their id, but string_to_field assumes
+    // a token, so confirm the name
+    auto const id =
+        string_to_field(name);
+    if( id != field::unknown &&
+        grammar::ci_is_equal(
+            name, to_string(id)))
+        return find(id);
     if(count == 0)
         return 0;
     std::size_t i = 0;
@@ -306,6 +331,7 @@ copy_table(
     void* dest,
     std::size_t n) const noexcept
 {
+    index();
     std::memcpy(
         reinterpret_cast<
             entry*>(dest) - n,
@@ -333,10 +359,45 @@ assign_to(
     auto const buf_ = dest.buf;
     auto const cbuf_ = dest.cbuf;
     auto const cap_ = dest.cap;
+    auto const mr_ = dest.mr;
+    auto const tc_ = dest.tc;
+    index();
     dest = *this;
     dest.buf = buf_;
     dest.cbuf = cbuf_;
     dest.cap = cap_;
+    dest.mr = mr_;
+    dest.lazy = nullptr;
+    // the target may change in place
+    dest.tc = tc_;
+    if(tc_)
+        tc_->clear();
+}
+
+char*
+header::
+allocate(std::size_t n) const
+{
+    if(! mr)
+        return new char[n];
+    return static_cast<char*>(
+        mr->allocate(n, alignof(entry)));
+}
+
+void
+header::
+deallocate(
+    char* p,
+    std::size_t n) const noexcept
+{
+    if(! p)
+        return;
+    if(! mr)
+    {
+        delete[] p;
+        return;
+    }
+    mr->deallocate(p, n, alignof(entry));
 }
 
 //------------------------------------------------
@@ -356,6 +417,8 @@ maybe_count(
     {
     case field::connection:
         return md.connection.count;
+    case field::content_encoding:
+        return md.content_encoding.count;
     case field::content_length:
         return md.content_length.count;
     case field::expect:
@@ -380,6 +443,7 @@ is_special(
     switch(id)
     {
     case field::connection:
+    case field::content_encoding:
     case field::content_length:
     case field::expect:
     case field::transfer_encoding:
@@ -414,12 +478,15 @@ on_insert(
     field id,
     core::string_view v)
 {
+    ids.insert(id);
     if(kind == detail::kind::fields)
         return;
     switch(id)
     {
     case field::content_length:
         return on_insert_content_length(v);
+    case field::content_encoding:
+        return on_insert_content_encoding(v);
     case field::connection:
         return on_insert_connection(v);
     case field::expect:
@@ -444,6 +511,8 @@ on_erase(field id)
     {
     case field::connection:
         return on_erase_connection();
+    case field::content_encoding:
+        return on_erase_content_encoding();
     case field::content_length:
         return on_erase_content_length();
     case field::expect:
@@ -494,6 +563,56 @@ on_insert_connection(
     }
 }
 
+/*
+    https://www.rfc-editor.org/rfc/rfc9110#section-8.4
+*/
+void
+header::
+on_insert_content_encoding(
+    core::string_view v)
+{
+    ++md.content_encoding.count;
+    if(md.content_encoding.ec.failed())
+        return;
+    auto rv = grammar::parse(
+        v, list_rule(token_rule, 1));
+    if(! rv)
+    {
+        md.content_encoding.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_content_encoding);
+        md.content_encoding.encoding =
+            encoding::identity;
+        return;
+    }
+    // only a single coding can be decoded
+    if( md.content_encoding.count > 1 ||
+        rv->size() > 1)
+    {
+        md.content_encoding.encoding =
+            encoding::unknown;
+        return;
+    }
+    auto const t = *rv->begin();
+    if(grammar::ci_is_equal(t, "deflate"))
+        md.content_encoding.encoding =
+            encoding::deflate;
+    else if(
+        grammar::ci_is_equal(t, "gzip") ||
+        grammar::ci_is_equal(t, "x-gzip"))
+        md.content_encoding.encoding =
+            encoding::gzip;
+    else if(grammar::ci_is_equal(t, "br"))
+        md.content_encoding.encoding =
+            encoding::br;
+    else if(grammar::ci_is_equal(t, "identity"))
+        md.content_encoding.encoding =
+            encoding::identity;
+    else
+        md.content_encoding.encoding =
+            encoding::unknown;
+}
+
 void
 header::
 on_insert_content_length(
@@ -590,6 +709,8 @@ on_insert_transfer_encoding()
                     error::bad_transfer_encoding);
             md.transfer_encoding.codings = 0;
             md.transfer_encoding.is_chunked = false;
+            md.transfer_encoding.encoding =
+                encoding::identity;
             update_payload();
             return;
         }
@@ -599,7 +720,24 @@ on_insert_transfer_encoding()
             if(! md.transfer_encoding.is_chunked)
             {
                 if(t.id == transfer_coding::chunked)
+                {
                     md.transfer_encoding.is_chunked = true;
+                    continue;
+                }
+                // only a single coding can be decoded
+                if(md.transfer_encoding.encoding !=
+                        encoding::identity)
+                    md.transfer_encoding.encoding =
+                        encoding::unknown;
+                else if(t.id == transfer_coding::deflate)
+                    md.transfer_encoding.encoding =
+                        encoding::deflate;
+                else if(t.id == transfer_coding::gzip)
+                    md.transfer_encoding.encoding =
+                        encoding::gzip;
+                else
+                    md.transfer_encoding.encoding =
+                        encoding::unknown;
                 continue;
             }
             if(t.id == transfer_coding::chunked)
@@ -610,6 +748,8 @@ on_insert_transfer_encoding()
                         error::bad_transfer_encoding);
                 md.transfer_encoding.codings = 0;
                 md.transfer_encoding.is_chunked = false;
+                md.transfer_encoding.encoding =
+                    encoding::identity;
                 update_payload();
                 return;
             }
@@ -619,6 +759,8 @@ on_insert_transfer_encoding()
                     error::bad_transfer_encoding);
             md.transfer_encoding.codings = 0;
             md.transfer_encoding.is_chunked = false;
+            md.transfer_encoding.encoding =
+                encoding::identity;
             update_payload();
             return;
         }
@@ -692,6 +834,35 @@ on_erase_connection()
     }
 }
 
+void
+header::
+on_erase_content_encoding()
+{
+    BOOST_ASSERT(
+        md.content_encoding.count > 0);
+    --md.content_encoding.count;
+    if(md.content_encoding.count == 0)
+    {
+        // no Content-Encoding
+        md.content_encoding = {};
+        return;
+    }
+    // reset and re-insert
+    auto n = md.content_encoding.count;
+    auto const p = cbuf + prefix;
+    auto const* e = &tab()[0];
+    md.content_encoding = {};
+    while(n > 0)
+    {
+        if(e->id == field::content_encoding)
+            on_insert_content_encoding(
+                core::string_view(
+                    p + e->vp, e->vn));
+        --n;
+        --e;
+    }
+}
+
 void
 header::
 on_erase_content_length()
@@ -823,6 +994,7 @@ header::
 on_erase_all(
     field id)
 {
+    ids.erase(id);
     if(kind == detail::kind::fields)
         return;
     switch(id)
@@ -831,6 +1003,10 @@ on_erase_all(
         md.connection = {};
         return;
 
+    case field::content_encoding:
+        md.content_encoding = {};
+        return;
+
     case field::content_length:
         md.content_length = {};
         update_payload();
@@ -1003,26 +1179,8 @@ header::
 count_crlf(
     core::string_view s) noexcept
 {
-    auto it = s.data();
-    auto len = s.size();
-    std::size_t n = 0;
-    while(len >= 2)
-    {
-        if( it[0] == '\r' &&
-            it[1] != '\r')
-        {
-            if(it[1] == '\n')
-                n++;
-            it += 2;
-            len -= 2;
-        }
-        else
-        {
-            it++;
-            len--;
-        }
-    }
-    return n;
+    return count_crlf_pairs(
+        s.data(), s.data() + s.size());
 }
 
 static
@@ -1127,6 +1285,83 @@ parse_start_line(
     h.on_start_line();
 }
 
+// Append a parsed field line ending at `it`
+static
+void
+add_field(
+    header& h,
+    char const* it,
+    field_rule_t::value_type const& fv) noexcept
+{
+    auto id = (h.lazy && h.lazy->load(
+            std::memory_order_relaxed) ==
+                header::lazy_pending) ?
+        header::eager_field(fv.name) :
+        string_to_field(fv.name);
+    h.size = static_cast<offset_type>(it - h.cbuf);
+
+    // add field table entry
+    if(h.buf != nullptr)
+    {
+        auto& e = header::table(
+            h.buf + h.cap)[h.count];
+        auto const base =
+            h.buf + h.prefix;
+        e.np = static_cast<offset_type>(
+            fv.name.data() - base);
+        e.nn = static_cast<offset_type>(
+            fv.name.size());
+        e.vp = static_cast<offset_type>(
+            fv.value.data() - base);
+        e.vn = static_cast<offset_type>(
+            fv.value.size());
+        e.id = id;
+    }
+    ++h.count;
+    h.on_insert(id, fv.value);
+}
+
+// Parse the common form of a field line:
+//
+//  token ":" OWS *( SP / HTAB / field-vchar ) CRLF
+//
+// where the next line does not begin an
+// obs-fold. Anything else, including errors
+// and incomplete input, returns false and
+// is left to the strict grammar.
+static
+bool
+parse_field_fast(
+    char const*& it,
+    char const* end,
+    core::string_view& name,
+    core::string_view& value) noexcept
+{
+    auto p = find_non_tchar(it, end);
+    if( p == it ||
+        p == end ||
+        *p != ':')
+        return false;
+    auto const n0 = it;
+    auto const n1 = p;
+    auto const v1 = find_ctl(++p, end);
+    if( end - v1 < 3 ||
+        v1[0] != '\r' ||
+        v1[1] != '\n' ||
+        ws(v1[2]))
+        return false;
+    auto v0 = p;
+    while(v0 != v1 && ws(*v0))
+        ++v0;
+    p = v1;
+    while(p != v0 && ws(p[-1]))
+        --p;
+    name = core::string_view(n0, n1 - n0);
+    value = core::string_view(v0, p - v0);
+    it = v1 + 2;
+    return true;
+}
+
 // returns: true if we added a field
 static
 void
@@ -1141,6 +1376,20 @@ parse_field(
     auto const it0 = h.cbuf + h.size;
     auto const end = h.cbuf + new_size;
     char const* it = it0;
+    field_rule_t::value_type fv;
+    if(parse_field_fast(
+        it, end, fv.name, fv.value))
+    {
+        if(h.count >= lim.max_fields)
+        {
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::fields_limit);
+            return;
+        }
+        add_field(h, it, fv);
+        ec = {};
+        return;
+    }
     auto rv = grammar::parse(
         it, end, field_rule);
     if(rv.has_error())
@@ -1173,28 +1422,7 @@ parse_field(
         BOOST_ASSERT(h.buf != nullptr);
         remove_obs_fold(h.buf + h.size, it);
     }
-    auto id = string_to_field(rv->name);
-    h.size = static_cast<offset_type>(it - h.cbuf);
-
-    // add field table entry
-    if(h.buf != nullptr)
-    {
-        auto& e = header::table(
-            h.buf + h.cap)[h.count];
-        auto const base =
-            h.buf + h.prefix;
-        e.np = static_cast<offset_type>(
-            rv->name.data() - base);
-        e.nn = static_cast<offset_type>(
-            rv->name.size());
-        e.vp = static_cast<offset_type>(
-            rv->value.data() - base);
-        e.vn = static_cast<offset_type>(
-            rv->value.size());
-        e.id = id;
-    }
-    ++h.count;
-    h.on_insert(id, rv->value);
+    add_field(h, it, *rv);
     ec = {};
 }
 
@@ -1244,6 +1472,107 @@ parse(
         ec = {};
 }
 
+// Returns the id of a field which a lazy
+// header resolves while parsing: those
+// which affect the payload, and Host.
+field
+header::
+eager_field(
+    core::string_view name) noexcept
+{
+    field id;
+    switch(name.size())
+    {
+    case 4: id = field::host; break;
+    case 6: id = field::expect; break;
+    case 7: id = field::upgrade; break;
+    case 10: id = field::connection; break;
+    case 14: id = field::content_length; break;
+    case 16: id = field::content_encoding; break;
+    case 17: id = field::transfer_encoding; break;
+    default:
+        return field::unknown;
+    }
+    if(grammar::ci_is_equal(
+            name, to_string(id)))
+        return id;
+    return field::unknown;
+}
+
+// Look up the ids deferred by a lazy
+// header. Views of the parser's header
+// may be read from several threads at
+// once, so the first reader claims the
+// state and the others wait until the
+// ids are published. Only the entries
+// and the id set are written, and no
+// reader sees them before that.
+void
+header::
+index() const noexcept
+{
+    if(! lazy)
+        return;
+    auto s = lazy->load(
+        std::memory_order_acquire);
+    for(;;)
+    {
+        if(s == lazy_done)
+            return;
+        if( s == lazy_pending &&
+            lazy->compare_exchange_weak(
+                s, lazy_busy,
+                std::memory_order_acquire,
+                std::memory_order_acquire))
+            break;
+        if(s == lazy_busy)
+        {
+            std::this_thread::yield();
+            s = lazy->load(
+                std::memory_order_acquire);
+        }
+    }
+    auto& h = const_cast<header&>(*this);
+    auto const* p = cbuf + prefix;
+    auto e = h.tab_();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        --e;
+        if(e->id != field::unknown)
+            continue;
+        e->id = string_to_field(
+            core::string_view(
+                p + e->np, e->nn));
+        h.ids.insert(e->id);
+    }
+    lazy->store(lazy_done,
+        std::memory_order_release);
+}
+
+// Look up the deferred ids, unless
+// `id` is resolved while parsing
+void
+header::
+index(field id) const noexcept
+{
+    if(! lazy)
+        return;
+    switch(id)
+    {
+    case field::host:
+    case field::expect:
+    case field::upgrade:
+    case field::connection:
+    case field::content_length:
+    case field::content_encoding:
+    case field::transfer_encoding:
+        break;
+    default:
+        index();
+        break;
+    }
+}
+
 } // detail
 } // http_proto
 } // boost
@@ -15,6 +15,7 @@
 #include <boost/http_proto/detail/header.hpp>
 #include <boost/core/span.hpp>
 #include <cstddef>
+#include <cstring>
 
 namespace boost {
 namespace http_proto {
@@ -25,8 +26,16 @@ struct prefix_op
     message_base& mb_;
     span<char> prefix_;
     char* buf_ = nullptr;
+    std::size_t cap_ = 0;
     std::size_t n_ = 0;
 
+    // a longer prefix which fits in the
+    // capacity is written here, or past
+    // the end of the fields, first, since
+    // the new start-line may refer to the
+    // old one or to the fields
+    char tmp_[128];
+
     prefix_op(
         message_base& mb,
         std::size_t n)
@@ -52,7 +61,29 @@ struct prefix_op
             n + h.size - h.prefix,
             h.count);
 
-        auto p = new char[n1];
+        if( h.buf && n1 <= h.cap )
+        {
+            // grow in place
+            if( n <= sizeof(tmp_) )
+            {
+                prefix_ = {tmp_, n};
+                return;
+            }
+            // or write the prefix past the
+            // moved fields, if there is room
+            auto const end = h.cap -
+                h.count * sizeof(header::entry);
+            auto const size =
+                n + h.size - h.prefix;
+            if( end >= size &&
+                end - size >= n )
+            {
+                prefix_ = {h.buf + end - n, n};
+                return;
+            }
+        }
+
+        auto p = h.allocate(n1);
         if( h.buf != nullptr )
         {
             std::memcpy(
@@ -71,6 +102,7 @@ struct prefix_op
 
         prefix_ = {p, n};
         buf_ = h.buf;
+        cap_ = h.cap;
 
         h.buf = p;
         h.cbuf = p;
@@ -88,6 +120,22 @@ struct prefix_op
     ~prefix_op()
     {
         auto& h = mb_.h_;
+        if( prefix_.data() != h.buf )
+        {
+            // grown in place
+            std::memmove(
+                h.buf + n_,
+                h.buf + h.prefix,
+                h.size - h.prefix);
+            std::memcpy(
+                h.buf, prefix_.data(), n_);
+            h.size = static_cast<
+                offset_type>(h.size +
+                    n_ - h.prefix);
+            h.prefix = static_cast<
+                offset_type>(n_);
+            return;
+        }
         if( n_ < h.prefix )
         {
             std::memmove(
@@ -100,7 +148,7 @@ struct prefix_op
             h.prefix = static_cast<
                 offset_type>(n_);
         }
-        delete[] buf_;
+        h.deallocate(buf_, cap_);
     }
 };
 
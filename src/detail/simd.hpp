@@ -0,0 +1,394 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_SIMD_HPP
+#define BOOST_HTTP_PROTO_DETAIL_SIMD_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+# include <emmintrin.h>
+#endif
+#ifdef BOOST_HTTP_PROTO_USE_AVX2
+# include <immintrin.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Character scanners used by the header parser.
+
+    Each scanner examines 32 or 16 bytes at a
+    time when AVX2 or SSE2 is available, and
+    finishes the remainder one byte at a time.
+    Loads never extend past `end`.
+
+    The vector code compares bytes as signed
+    values, so every octet from 0x80 to 0xFF
+    is less than any ASCII character.
+*/
+
+#ifdef BOOST_HTTP_PROTO_USE_AVX2
+
+// bit i set if byte i is not a tchar
+inline
+std::uint32_t
+non_tchar_mask(__m256i v) noexcept
+{
+    auto const in = [v](char lo, char hi)
+    {
+        return _mm256_and_si256(
+            _mm256_cmpgt_epi8(v,
+                _mm256_set1_epi8(lo - 1)),
+            _mm256_cmpgt_epi8(
+                _mm256_set1_epi8(hi + 1), v));
+    };
+    auto const eq = [v](char c)
+    {
+        return _mm256_cmpeq_epi8(v,
+            _mm256_set1_epi8(c));
+    };
+    // delimiters within VCHAR
+    auto const delim = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_or_si256(
+                in('(', ')'), in(':', '@')),
+            _mm256_or_si256(
+                in('[', ']'), eq('"'))),
+        _mm256_or_si256(
+            _mm256_or_si256(eq(','), eq('/')),
+            _mm256_or_si256(eq('{'), eq('}'))));
+    return ~static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(
+            _mm256_andnot_si256(
+                delim, in(0x21, 0x7e))));
+}
+
+// bit i set if byte i is a CTL other than HTAB
+inline
+std::uint32_t
+ctl_mask(__m256i v) noexcept
+{
+    auto const ctl = _mm256_or_si256(
+        _mm256_and_si256(
+            _mm256_cmpgt_epi8(v,
+                _mm256_set1_epi8(-1)),
+            _mm256_cmpgt_epi8(
+                _mm256_set1_epi8(0x20), v)),
+        _mm256_cmpeq_epi8(v,
+            _mm256_set1_epi8(0x7f)));
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(
+            _mm256_andnot_si256(
+                _mm256_cmpeq_epi8(v,
+                    _mm256_set1_epi8('\t')),
+                ctl)));
+}
+
+#endif
+
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+
+// bit i set if byte i is not a tchar
+inline
+std::uint32_t
+non_tchar_mask(__m128i v) noexcept
+{
+    auto const in = [v](char lo, char hi)
+    {
+        return _mm_and_si128(
+            _mm_cmpgt_epi8(v,
+                _mm_set1_epi8(lo - 1)),
+            _mm_cmplt_epi8(v,
+                _mm_set1_epi8(hi + 1)));
+    };
+    auto const eq = [v](char c)
+    {
+        return _mm_cmpeq_epi8(v,
+            _mm_set1_epi8(c));
+    };
+    // delimiters within VCHAR
+    auto const delim = _mm_or_si128(
+        _mm_or_si128(
+            _mm_or_si128(
+                in('(', ')'), in(':', '@')),
+            _mm_or_si128(
+                in('[', ']'), eq('"'))),
+        _mm_or_si128(
+            _mm_or_si128(eq(','), eq('/')),
+            _mm_or_si128(eq('{'), eq('}'))));
+    return 0xffff ^ static_cast<std::uint32_t>(
+        _mm_movemask_epi8(
+            _mm_andnot_si128(
+                delim, in(0x21, 0x7e))));
+}
+
+// bit i set if byte i is a CTL other than HTAB
+inline
+std::uint32_t
+ctl_mask(__m128i v) noexcept
+{
+    auto const ctl = _mm_or_si128(
+        _mm_and_si128(
+            _mm_cmpgt_epi8(v,
+                _mm_set1_epi8(-1)),
+            _mm_cmplt_epi8(v,
+                _mm_set1_epi8(0x20))),
+        _mm_cmpeq_epi8(v,
+            _mm_set1_epi8(0x7f)));
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(
+            _mm_andnot_si128(
+                _mm_cmpeq_epi8(v,
+                    _mm_set1_epi8('\t')),
+                ctl)));
+}
+
+#endif
+
+//------------------------------------------------
+
+// Returns the first character in
+// [it, end) which is not a tchar.
+inline
+char const*
+find_non_tchar(
+    char const* it,
+    char const* end) noexcept
+{
+#ifdef BOOST_HTTP_PROTO_USE_AVX2
+    while(end - it >= 32)
+    {
+        auto const m = non_tchar_mask(
+            _mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(it)));
+        if(m != 0)
+            return it + core::countr_zero(m);
+        it += 32;
+    }
+#endif
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+    while(end - it >= 16)
+    {
+        auto const m = non_tchar_mask(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(it)));
+        if(m != 0)
+            return it + core::countr_zero(m);
+        it += 16;
+    }
+#endif
+    while(it != end && tchars(*it))
+        ++it;
+    return it;
+}
+
+// Returns the first character in [it, end)
+// which may not appear in a field-value:
+// anything except SP, HTAB, VCHAR, and
+// obs-text. A well-formed line stops at CR.
+inline
+char const*
+find_ctl(
+    char const* it,
+    char const* end) noexcept
+{
+#ifdef BOOST_HTTP_PROTO_USE_AVX2
+    while(end - it >= 32)
+    {
+        auto const m = ctl_mask(
+            _mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(it)));
+        if(m != 0)
+            return it + core::countr_zero(m);
+        it += 32;
+    }
+#endif
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+    while(end - it >= 16)
+    {
+        auto const m = ctl_mask(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(it)));
+        if(m != 0)
+            return it + core::countr_zero(m);
+        it += 16;
+    }
+#endif
+    while(it != end)
+    {
+        auto const c = static_cast<
+            unsigned char>(*it);
+        if( (c < 0x20 && c != '\t') ||
+            c == 0x7f)
+            break;
+        ++it;
+    }
+    return it;
+}
+
+// Returns the number of CRLF pairs in [it, end)
+inline
+std::size_t
+count_crlf_pairs(
+    char const* it,
+    char const* end) noexcept
+{
+    std::size_t n = 0;
+#ifdef BOOST_HTTP_PROTO_USE_AVX2
+    // the second load is one byte ahead
+    while(end - it > 32)
+    {
+        auto const cr = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(it)),
+            _mm256_set1_epi8('\r'));
+        auto const lf = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(it + 1)),
+            _mm256_set1_epi8('\n'));
+        n += core::popcount(
+            static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(
+                    _mm256_and_si256(cr, lf))));
+        it += 32;
+    }
+#endif
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+    while(end - it > 16)
+    {
+        auto const cr = _mm_cmpeq_epi8(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(it)),
+            _mm_set1_epi8('\r'));
+        auto const lf = _mm_cmpeq_epi8(
+            _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(it + 1)),
+            _mm_set1_epi8('\n'));
+        n += core::popcount(
+            static_cast<std::uint32_t>(
+                _mm_movemask_epi8(
+                    _mm_and_si128(cr, lf))));
+        it += 16;
+    }
+#endif
+    while(end - it >= 2)
+    {
+        if( it[0] == '\r' &&
+            it[1] == '\n')
+        {
+            ++n;
+            it += 2;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return n;
+}
+
+// Returns true if the n characters at p1 and
+// p2 are equal ignoring bit 5. This folds
+// case for letters, and is exact for field
+// names since no two tchars other than '^'
+// and '~' differ only in that bit.
+inline
+bool
+equal_ignore_bit5(
+    char const* p1,
+    char const* p2,
+    std::size_t n) noexcept
+{
+#ifdef BOOST_HTTP_PROTO_USE_SSE2
+    if(n >= 16)
+    {
+        auto const mask =
+            _mm_set1_epi8(static_cast<char>(0xDF));
+        auto const diff =
+            [&](std::size_t i)
+            {
+                auto const v = _mm_and_si128(
+                    _mm_xor_si128(
+                        _mm_loadu_si128(
+                            reinterpret_cast<
+                                __m128i const*>(p1 + i)),
+                        _mm_loadu_si128(
+                            reinterpret_cast<
+                                __m128i const*>(p2 + i))),
+                    mask);
+                return _mm_movemask_epi8(
+                    _mm_cmpeq_epi8(v,
+                        _mm_setzero_si128())) != 0xffff;
+            };
+        std::size_t i = 0;
+        for(; n - i > 16; i += 16)
+            if(diff(i))
+                return false;
+        // the last block may overlap
+        return ! diff(n - 16);
+    }
+#endif
+    // overlapping loads cover the tail
+    auto const load8 =
+        [](char const* p)
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        };
+    auto const load4 =
+        [](char const* p)
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        };
+    if(n >= 8)
+    {
+        auto constexpr mask =
+            0xDFDFDFDFDFDFDFDFull;
+        std::size_t i = 0;
+        for(; n - i > 8; i += 8)
+            if((load8(p1 + i) ^
+                    load8(p2 + i)) & mask)
+                return false;
+        return ((load8(p1 + n - 8) ^
+            load8(p2 + n - 8)) & mask) == 0;
+    }
+    if(n >= 4)
+        return (((load4(p1) ^ load4(p2)) |
+            (load4(p1 + n - 4) ^
+                load4(p2 + n - 4))) &
+            0xDFDFDFDFu) == 0;
+    for(; n; ++p1, ++p2, --n)
+        if((*p1 ^ *p2) & 0xDF)
+            return false;
+    return true;
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
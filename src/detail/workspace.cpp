@@ -10,6 +10,7 @@
 #include <boost/http_proto/detail/workspace.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/assert.hpp>
+#include "workspace_pool.hpp"
 
 namespace boost {
 namespace http_proto {
@@ -25,7 +26,10 @@ workspace::
     if(begin_)
     {
         clear();
-        delete[] begin_;
+        if(pool_)
+            pool_->release(begin_);
+        else
+            delete[] begin_;
     }
 }
 
@@ -48,6 +52,8 @@ workspace(
     , head_(other.end_)
     , back_(other.back_)
     , end_(other.end_)
+    , pool_(other.pool_)
+    , n_(other.n_)
 {
     other.begin_ = nullptr;
     other.front_ = nullptr;
@@ -76,6 +82,57 @@ allocate(
     end_ = head_;
 }
 
+void
+workspace::
+allocate(
+    std::size_t n,
+    workspace_pool& pool)
+{
+    // Cannot be empty
+    if(n == 0)
+        detail::throw_invalid_argument();
+
+    // Already allocated
+    if( begin_ != nullptr ||
+        pool_ != nullptr)
+        detail::throw_logic_error();
+
+    pool_ = &pool;
+    n_ = n;
+}
+
+void
+workspace::
+acquire()
+{
+    if( ! pool_ ||
+        begin_ != nullptr)
+        return;
+
+    begin_ = pool_->acquire(n_);
+    front_ = begin_;
+    head_ = begin_ + n_;
+    back_ = head_;
+    end_ = head_;
+}
+
+void
+workspace::
+release() noexcept
+{
+    if( ! pool_ ||
+        begin_ == nullptr)
+        return;
+
+    clear();
+    pool_->release(begin_);
+    begin_ = nullptr;
+    front_ = nullptr;
+    head_ = nullptr;
+    back_ = nullptr;
+    end_ = nullptr;
+}
+
 void
 workspace::
 clear() noexcept
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_WORKSPACE_POOL_HPP
+#define BOOST_HTTP_PROTO_DETAIL_WORKSPACE_POOL_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+class context;
+
+namespace detail {
+
+/*  A bounded, lock-free cache of storage
+    blocks for workspaces.
+
+    Each slot holds at most one block, taken
+    and returned with a single atomic exchange,
+    so no block can be handed out twice. Blocks
+    of different sizes share the slots; the size
+    is stored in front of each block.
+*/
+class workspace_pool
+    : public service
+{
+public:
+    using key_type = workspace_pool;
+
+    workspace_pool(
+        context& ctx,
+        std::size_t max_idle);
+
+    ~workspace_pool();
+
+    // Returns a block of exactly n bytes
+    unsigned char*
+    acquire(std::size_t n);
+
+    // Returns a block obtained from acquire
+    void
+    release(unsigned char* p) noexcept;
+
+private:
+    std::unique_ptr<
+        std::atomic<unsigned char*>[]> slots_;
+    std::size_t n_;
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,320 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/digest.hpp>
+#include <cstring>
+
+#ifdef BOOST_HTTP_PROTO_USE_SSE42
+# include <nmmintrin.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+#ifndef BOOST_HTTP_PROTO_USE_SSE42
+
+// tables for processing eight
+// bytes at a time, built once
+struct crc32c_tables
+{
+    std::uint32_t t[8][256];
+
+    crc32c_tables() noexcept
+    {
+        // reflected Castagnoli polynomial
+        std::uint32_t const poly = 0x82f63b78;
+        for(std::uint32_t i = 0; i < 256; ++i)
+        {
+            auto c = i;
+            for(int k = 0; k < 8; ++k)
+                c = (c >> 1) ^ (poly & (0 - (c & 1)));
+            t[0][i] = c;
+        }
+        for(std::size_t i = 0; i < 256; ++i)
+            for(std::size_t k = 1; k < 8; ++k)
+                t[k][i] = (t[k - 1][i] >> 8) ^
+                    t[0][t[k - 1][i] & 0xff];
+    }
+};
+
+crc32c_tables const&
+get_crc32c_tables() noexcept
+{
+    static crc32c_tables const tab;
+    return tab;
+}
+
+#endif
+
+std::uint32_t
+load_be32(unsigned char const* p) noexcept
+{
+    return
+        (std::uint32_t(p[0]) << 24) |
+        (std::uint32_t(p[1]) << 16) |
+        (std::uint32_t(p[2]) <<  8) |
+         std::uint32_t(p[3]);
+}
+
+void
+store_be32(
+    unsigned char* p,
+    std::uint32_t v) noexcept
+{
+    p[0] = static_cast<unsigned char>(v >> 24);
+    p[1] = static_cast<unsigned char>(v >> 16);
+    p[2] = static_cast<unsigned char>(v >>  8);
+    p[3] = static_cast<unsigned char>(v);
+}
+
+std::uint32_t
+rotr(std::uint32_t x, int n) noexcept
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+std::uint32_t const sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+// process one 64-byte block
+void
+sha256_block(
+    std::uint32_t* h,
+    unsigned char const* p) noexcept
+{
+    std::uint32_t w[64];
+    for(int i = 0; i < 16; ++i)
+        w[i] = load_be32(p + 4 * i);
+    for(int i = 16; i < 64; ++i)
+    {
+        auto const s0 =
+            rotr(w[i - 15], 7) ^
+            rotr(w[i - 15], 18) ^
+            (w[i - 15] >> 3);
+        auto const s1 =
+            rotr(w[i - 2], 17) ^
+            rotr(w[i - 2], 19) ^
+            (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    auto a = h[0];
+    auto b = h[1];
+    auto c = h[2];
+    auto d = h[3];
+    auto e = h[4];
+    auto f = h[5];
+    auto g = h[6];
+    auto hh = h[7];
+    for(int i = 0; i < 64; ++i)
+    {
+        auto const s1 =
+            rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        auto const ch = (e & f) ^ (~e & g);
+        auto const t1 =
+            hh + s1 + ch + sha256_k[i] + w[i];
+        auto const s0 =
+            rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        auto const maj =
+            (a & b) ^ (a & c) ^ (b & c);
+        auto const t2 = s0 + maj;
+        hh = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+    h[5] += f;
+    h[6] += g;
+    h[7] += hh;
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+void
+crc32c::
+update(
+    void const* data,
+    std::size_t size) noexcept
+{
+    auto p = static_cast<
+        unsigned char const*>(data);
+    auto v = v_;
+#ifdef BOOST_HTTP_PROTO_USE_SSE42
+# if defined(_M_X64) || defined(__x86_64__)
+    std::uint64_t v64 = v;
+    while(size >= 8)
+    {
+        std::uint64_t x;
+        std::memcpy(&x, p, 8);
+        v64 = _mm_crc32_u64(v64, x);
+        p += 8;
+        size -= 8;
+    }
+    v = static_cast<std::uint32_t>(v64);
+# endif
+    while(size >= 4)
+    {
+        std::uint32_t x;
+        std::memcpy(&x, p, 4);
+        v = _mm_crc32_u32(v, x);
+        p += 4;
+        size -= 4;
+    }
+    while(size > 0)
+    {
+        v = _mm_crc32_u8(v, *p++);
+        --size;
+    }
+#else
+    auto const& t = get_crc32c_tables().t;
+    while(size >= 8)
+    {
+        v ^=
+             std::uint32_t(p[0]) |
+            (std::uint32_t(p[1]) <<  8) |
+            (std::uint32_t(p[2]) << 16) |
+            (std::uint32_t(p[3]) << 24);
+        v =
+            t[7][ v        & 0xff] ^
+            t[6][(v >>  8) & 0xff] ^
+            t[5][(v >> 16) & 0xff] ^
+            t[4][ v >> 24        ] ^
+            t[3][p[4]] ^
+            t[2][p[5]] ^
+            t[1][p[6]] ^
+            t[0][p[7]];
+        p += 8;
+        size -= 8;
+    }
+    while(size > 0)
+    {
+        v = (v >> 8) ^ t[0][(v ^ *p++) & 0xff];
+        --size;
+    }
+#endif
+    v_ = v;
+}
+
+auto
+crc32c::
+digest() const noexcept ->
+    digest_type
+{
+    digest_type d;
+    store_be32(d.data(), value());
+    return d;
+}
+
+//------------------------------------------------
+
+sha256::
+sha256() noexcept
+    : h_{
+        0x6a09e667, 0xbb67ae85,
+        0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c,
+        0x1f83d9ab, 0x5be0cd19 }
+{
+}
+
+void
+sha256::
+update(
+    void const* data,
+    std::size_t size) noexcept
+{
+    auto p = static_cast<
+        unsigned char const*>(data);
+    auto used = static_cast<
+        std::size_t>(size_ % 64);
+    size_ += size;
+    if(used > 0)
+    {
+        auto n = 64 - used;
+        if( n > size)
+            n = size;
+        std::memcpy(buf_ + used, p, n);
+        p += n;
+        size -= n;
+        if(used + n < 64)
+            return;
+        sha256_block(h_, buf_);
+    }
+    while(size >= 64)
+    {
+        sha256_block(h_, p);
+        p += 64;
+        size -= 64;
+    }
+    if(size > 0)
+        std::memcpy(buf_, p, size);
+}
+
+auto
+sha256::
+digest() const noexcept ->
+    digest_type
+{
+    // pad a copy, so that more
+    // data may still be added
+    std::uint32_t h[8];
+    std::memcpy(h, h_, sizeof(h));
+    unsigned char b[128];
+    auto const used = static_cast<
+        std::size_t>(size_ % 64);
+    std::memcpy(b, buf_, used);
+    b[used] = 0x80;
+    auto const n = used < 56 ? 64 : 128;
+    std::memset(b + used + 1, 0,
+        n - used - 1 - 8);
+    auto const bits = size_ * 8;
+    store_be32(b + n - 8,
+        static_cast<std::uint32_t>(bits >> 32));
+    store_be32(b + n - 4,
+        static_cast<std::uint32_t>(bits));
+    sha256_block(h, b);
+    if(n == 128)
+        sha256_block(h, b + 64);
+
+    digest_type d;
+    for(int i = 0; i < 8; ++i)
+        store_be32(d.data() + 4 * i, h[i]);
+    return d;
+}
+
+} // http_proto
+} // boost
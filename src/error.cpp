@@ -45,8 +45,10 @@ message(
     case error::end_of_stream: return "end of stream";
     case error::in_place_overflow: return "in place overflow";
     case error::need_data: return "need data";
+    case error::need_file: return "need file";
 
     case error::bad_connection: return "bad Connection";
+    case error::bad_content_encoding: return "bad Content-Encoding";
     case error::bad_content_length: return "bad Content-Length";
     case error::bad_expect: return "bad Expect";
     case error::bad_field_name: return "bad field name";
@@ -55,6 +57,7 @@ message(
     case error::bad_line_ending: return "bad line ending";
     case error::bad_list: return "bad list";
     case error::bad_method: return "bad method";
+    case error::bad_multipart: return "bad multipart";
     case error::bad_number: return "bad number";
     case error::bad_payload: return "bad payload";
     case error::bad_version: return "bad version";
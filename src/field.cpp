@@ -7,12 +7,15 @@
 // Official repository: https://github.com/cppalliance/http_proto
 //
 
+#include "detail/simd.hpp"
+
 #include <boost/http_proto/field.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/assert.hpp>
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <iterator>
 #include <ostream>
 
 namespace boost {
@@ -41,33 +44,42 @@ struct field_table
     using array_type = std::array<
         core::string_view, 357>;
 
-    // Strings are converted to lowercase
+    // Strings are converted to lowercase.
+    // The length and three windows of four
+    // characters distinguish every known name.
     static
-    std::uint32_t
-    digest(core::string_view s)
+    std::uint64_t
+    digest(core::string_view s) noexcept
     {
-        std::uint32_t r = 0;
-        std::size_t n = s.size();
+        BOOST_ASSERT(! s.empty());
+        auto const n = s.size();
         auto p = reinterpret_cast<
             unsigned char const*>(s.data());
-        // consume N characters at a time
-        // VFALCO Can we do 8 on 64-bit systems?
-        while(n >= 4)
+        std::uint64_t a;
+        std::uint64_t b;
+        std::uint64_t c;
+        if(n >= 4)
         {
-            auto const v = get_chars(p);
-            r = (r * 5 + (
-                v | 0x20202020 )); // convert to lower
-            p += 4;
-            n -= 4;
+            // the windows may overlap
+            a = get_chars(p);
+            b = get_chars(p + (n - 4) / 2);
+            c = get_chars(p + n - 4);
         }
-        // handle remaining characters
-        while( n > 0 )
+        else
         {
-            r = r * 5 + ( *p | 0x20 );
-            ++p;
-            --n;
+            a = p[0];
+            b = p[n / 2];
+            c = p[n - 1];
         }
-        return r;
+        auto constexpr lower = 0x2020202020202020;
+        std::uint64_t const k0 =
+            (a | (c << 32)) | lower;
+        std::uint64_t const k1 =
+            (b | (std::uint64_t(n) << 32)) |
+                (lower >> 32);
+        return
+            k0 * 0x9e3779b97f4a7c15 ^
+            k1 * 0xff51afd7ed558ccd;
     }
 
     // This comparison is case-insensitive, and the
@@ -76,36 +88,58 @@ struct field_table
     bool
     equals(
         core::string_view lhs,
-        core::string_view rhs)
+        core::string_view rhs) noexcept
     {
-        using Int = std::uint32_t; // VFALCO std::size_t?
-        auto n = lhs.size();
-        if(n != rhs.size())
-            return false;
-        auto p1 = reinterpret_cast<
-            unsigned char const*>(lhs.data());
-        auto p2 = reinterpret_cast<
-            unsigned char const*>(rhs.data());
-        auto constexpr S = sizeof(Int);
-        auto constexpr Mask = static_cast<Int>(
-            0xDFDFDFDFDFDFDFDF & ~Int{0});
-        for(; n >= S; p1 += S, p2 += S, n -= S)
-        {
-            Int const v1 = get_chars(p1);
-            Int const v2 = get_chars(p2);
-            if((v1 ^ v2) & Mask)
-                return false;
-        }
-        for(; n; ++p1, ++p2, --n)
-            if(( *p1 ^ *p2) & 0xDF)
-                return false;
-        return true;
+        return
+            lhs.size() == rhs.size() &&
+            equal_ignore_bit5(
+                lhs.data(), rhs.data(), lhs.size());
+    }
+
+    /*  Hash and displace
+
+        Names are grouped into B buckets by their
+        digest. Each bucket stores a displacement
+        which sends all of its names to distinct
+        empty slots out of M. A lookup therefore
+        reads one displacement, one slot, and
+        compares against at most one name.
+
+        If some bucket cannot be placed, as when
+        two names share a digest, the table is
+        built with linear probing instead, and
+        a lookup walks the slots from the first
+        one until it finds the name or a hole.
+    */
+    static constexpr std::size_t B = 128;
+    static constexpr std::size_t M = 1024;
+
+    static
+    std::size_t
+    bucket(std::uint64_t h) noexcept
+    {
+        return static_cast<std::size_t>(h >> 57);
+    }
+
+    static
+    std::size_t
+    slot(
+        std::uint64_t h,
+        std::uint64_t d) noexcept
+    {
+        return static_cast<std::size_t>(((
+            h ^ (d * 0xc2b2ae3d27d4eb4f)) *
+                0x165667b19e3779f9) >> 54);
     }
 
     array_type by_name_;
 
-    enum { N = 5155 };
-    unsigned char map_[ N ][ 2 ] = {};
+    // the most displacements tried per bucket
+    static constexpr std::size_t max_disp = 4096;
+
+    std::uint16_t disp_[ B ] = {};
+    std::uint16_t map_[ M ] = {};
+    bool probe_ = false;
 
 /*
     From:
@@ -474,22 +508,104 @@ struct field_table
 "Xref"
         }})
     {
-        for(std::size_t i = 1, n = 256; i < n; ++i)
+        static_assert(B == (std::size_t(1) << 7), "");
+        static_assert(M == (std::size_t(1) << 10), "");
+        static_assert(M > std::tuple_size<
+            array_type>::value, "");
+
+        std::uint64_t h[ std::tuple_size<
+            array_type>::value ];
+        std::uint16_t order[ std::tuple_size<
+            array_type>::value - 1 ];
+        std::size_t size[ B ] = {};
+        for(std::size_t i = 1; i < by_name_.size(); ++i)
         {
-            auto sv = by_name_[ i ];
-            auto h = digest(sv);
-            auto j = h % N;
-            BOOST_ASSERT(map_[j][0] == 0);
-            map_[j][0] = static_cast<unsigned char>(i);
+            h[i] = digest(by_name_[i]);
+            ++size[bucket(h[i])];
+            order[i - 1] =
+                static_cast<std::uint16_t>(i);
         }
 
-        for(std::size_t i = 256, n = by_name_.size(); i < n; ++i)
+        // place the largest buckets first
+        std::sort(
+            std::begin(order), std::end(order),
+            [&](std::uint16_t i, std::uint16_t j)
+            {
+                auto const bi = bucket(h[i]);
+                auto const bj = bucket(h[j]);
+                if(size[bi] != size[bj])
+                    return size[bi] > size[bj];
+                return bi < bj;
+            });
+
+        auto first = std::begin(order);
+        while(first != std::end(order))
+        {
+            auto const b = bucket(h[*first]);
+            auto const last = first + size[b];
+            std::size_t d = 0;
+            for(; d < max_disp; ++d)
+            {
+                auto it = first;
+                for(; it != last; ++it)
+                {
+                    auto& e = map_[slot(h[*it], d)];
+                    if(e != 0)
+                        break;
+                    e = *it;
+                }
+                if(it == last)
+                {
+                    disp_[b] = static_cast<
+                        std::uint16_t>(d);
+                    break;
+                }
+                // undo
+                while(it != first)
+                    map_[slot(h[*--it], d)] = 0;
+            }
+            if(d == max_disp)
+            {
+                build_probe(h);
+                return;
+            }
+            first = last;
+        }
+    }
+
+    void
+    build_probe(
+        std::uint64_t const* h) noexcept
+    {
+        probe_ = true;
+        std::fill(
+            std::begin(map_), std::end(map_),
+            std::uint16_t(0));
+        for(std::size_t i = 1; i < by_name_.size(); ++i)
         {
-            auto sv = by_name_[i];
-            auto h = digest(sv);
-            auto j = h % N;
-            BOOST_ASSERT(map_[j][1] == 0);
-            map_[j][1] = static_cast<unsigned char>(i - 255);
+            auto j = slot(h[i], 0);
+            while(map_[j] != 0)
+                j = (j + 1) % M;
+            map_[j] = static_cast<
+                std::uint16_t>(i);
+        }
+    }
+
+    field
+    probe(
+        core::string_view s,
+        std::uint64_t h) const noexcept
+    {
+        // M is larger than the number of
+        // names, so there is always a hole
+        for(auto j = slot(h, 0);;
+            j = (j + 1) % M)
+        {
+            auto const i = map_[j];
+            if(i == 0)
+                return field::unknown;
+            if(equals(s, by_name_[i]))
+                return static_cast<field>(i);
         }
     }
 
@@ -497,19 +613,15 @@ struct field_table
     string_to_field(
         core::string_view s) const noexcept
     {
-        auto h = digest(s);
-        auto j = h % N;
-        int i = map_[j][0];
-        core::string_view s2 = by_name_[i];
-        if(i != 0 && equals(s, s2))
-            return static_cast<field>(i);
-        i = map_[j][1];
-        if(i == 0)
+        if(s.empty())
             return field::unknown;
-        i += 255;
-        s2 = by_name_[i];
-
-        if(equals(s, s2))
+        auto const h = digest(s);
+        if(probe_)
+            return probe(s, h);
+        auto const i = map_[
+            slot(h, disp_[bucket(h)])];
+        if( i != 0 &&
+            equals(s, by_name_[i]))
             return static_cast<field>(i);
         return field::unknown;
     }
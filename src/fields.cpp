@@ -27,6 +27,16 @@ fields() noexcept
 {
 }
 
+fields::
+fields(
+    container::pmr::memory_resource& mr) noexcept
+    : fields_view_base(
+        &this->fields_base::h_)
+    , fields_base(
+        detail::kind::fields, &mr)
+{
+}
+
 fields::
 fields(
     core::string_view s)
@@ -64,6 +74,9 @@ fields(
         &this->fields_base::h_)
     , fields_base(other.h_.kind)
 {
+    // the new object uses the same
+    // resource, as pmr containers do
+    h_.mr = other.h_.mr;
     swap(other);
 }
 
@@ -88,8 +101,15 @@ fields(
 fields&
 fields::
 operator=(
-    fields&& other) noexcept
+    fields&& other)
 {
+    // storage from another resource is
+    // copied, as pmr containers do
+    if(h_.mr != other.h_.mr)
+    {
+        copy_impl(*other.ph_);
+        return *this;
+    }
     fields tmp(std::move(other));
     tmp.swap(*this);
     return *this;
@@ -19,6 +19,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/target_cache.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/assert/source_location.hpp>
@@ -105,8 +106,7 @@ public:
 
     ~op_t()
     {
-        if(buf_)
-            delete[] buf_;
+        self_.h_.deallocate(buf_, cap_);
     }
 
     char const*
@@ -137,7 +137,8 @@ public:
     std::size_t
     growth(
         std::size_t n0,
-        std::size_t m) noexcept;
+        std::size_t m,
+        std::size_t max) noexcept;
 
     bool
     reserve(std::size_t bytes);
@@ -161,31 +162,46 @@ public:
 
 /*  Growth functions for containers
 
-    N1 = g( N0,  M );
+    N1 = g( N0,  M, X );
 
     g  = growth function
     M  = minimum capacity
+    X  = maximum capacity
     N0 = old size
     N1 = new size
+
+    Growth is geometric, so that building
+    a header one field at a time reallocates
+    a logarithmic number of times.
 */
 std::size_t
 fields_base::
 op_t::
 growth(
     std::size_t n0,
-    std::size_t m) noexcept
+    std::size_t m,
+    std::size_t max) noexcept
 {
     auto const m1 =
         detail::align_up(m, alignof(entry));
     BOOST_ASSERT(m1 >= m);
+    if(m1 <= n0)
+        return n0;
     if(n0 == 0)
     {
-        // exact
+        // exact, so that copies
+        // are not oversized
         return m1;
     }
-    if(m1 > n0)
+    if(n0 > max / 2)
+    {
+        // reserve throws
+        // if m1 > max
+        return m1 > max ? m1 : max;
+    }
+    if(m1 > 2 * n0)
         return m1;
-    return n0;
+    return 2 * n0;
 }
 
 bool
@@ -199,17 +215,19 @@ reserve(
         // max capacity exceeded
         detail::throw_length_error();
     }
-    auto n = growth(
-        self_.h_.cap, bytes);
+    auto const n = detail::align_up(
+        bytes, alignof(entry));
     if(n <= self_.h_.cap)
         return false;
-    auto buf = new char[n];
+    auto buf = self_.h_.allocate(n);
     buf_ = self_.h_.buf;
     cbuf_ = self_.h_.cbuf;
     cap_ = self_.h_.cap;
     self_.h_.buf = buf;
     self_.h_.cbuf = buf;
     self_.h_.cap = n;
+    if(self_.h_.tc)
+        self_.h_.tc->clear();
     return true;
 }
 
@@ -236,7 +254,8 @@ grow(
         self_.h_.cap,
         detail::header::bytes_needed(
             self_.h_.size + extra_char,
-            self_.h_.count + extra_field));
+            self_.h_.count + extra_field),
+        self_.max_capacity_in_bytes());
     return reserve(n1);
 }
 
@@ -282,6 +301,16 @@ fields_base(
 {
 }
 
+fields_base::
+fields_base(
+    detail::kind k,
+    container::pmr::memory_resource* mr) noexcept
+    : fields_view_base(&h_)
+    , h_(k)
+{
+    h_.mr = mr;
+}
+
 fields_base::
 fields_base(
     detail::kind k,
@@ -354,7 +383,8 @@ fields_base(
 // construct a complete copy of h
 fields_base::
 fields_base(
-    detail::header const& h)
+    detail::header const& h,
+    container::pmr::memory_resource* mr)
     : fields_view_base(&h_)
     , h_(h.kind)
 {
@@ -363,10 +393,12 @@ fields_base(
         BOOST_ASSERT(h.cap == 0);
         BOOST_ASSERT(h.buf == nullptr);
         h_ = h;
+        h_.mr = mr;
         return;
     }
 
     // allocate and copy the buffer
+    h_.mr = mr;
     op_t op(*this);
     op.grow(h.size, h.count);
     h.assign_to(h_);
@@ -380,8 +412,7 @@ fields_base(
 fields_base::
 ~fields_base()
 {
-    if(h_.buf)
-        delete[] h_.buf;
+    h_.deallocate(h_.buf, h_.cap);
 }
 
 //------------------------------------------------
@@ -413,6 +444,12 @@ fields_base::
 reserve_bytes(
     std::size_t n)
 {
+    // never less than the contents
+    auto const n0 =
+        detail::header::bytes_needed(
+            h_.size, h_.count);
+    if( n < n0)
+        n = n0;
     op_t op(*this);
     if(! op.reserve(n))
         return;
@@ -435,7 +472,7 @@ shrink_to_fit() noexcept
         h_.size, h_.count) >=
             h_.cap)
         return;
-    fields_base tmp(h_);
+    fields_base tmp(h_, h_.mr);
     tmp.h_.swap(h_);
 }
 
@@ -445,6 +482,118 @@ shrink_to_fit() noexcept
 //
 //------------------------------------------------
 
+system::result<void>
+fields_base::
+append(
+    std::initializer_list<std::pair<
+        field, core::string_view>> init)
+{
+    if(init.size() == 0)
+        return {};
+
+    // an upper bound on the size, since
+    // whitespace is trimmed from values
+    std::size_t n = 0;
+    std::size_t const max =
+        max_offset - h_.size;
+    for(auto const& f : init)
+    {
+        BOOST_ASSERT(
+            f.first != field::unknown);
+        auto const n1 =
+            to_string(f.first).size() +
+            2 +                 // ':' SP
+            f.second.size() +
+            2;                  // CRLF
+        if(n1 > max - n)
+            detail::throw_length_error();
+        n += n1;
+    }
+
+    // the old buffer, if any, is kept
+    // until we return, since the values
+    // might point into it
+    op_t op(*this);
+    if(op.grow(n, init.size()))
+    {
+        // reallocated
+        std::memcpy(
+            h_.buf, op.cbuf(), h_.size);
+        auto const nt =
+            sizeof(entry) * h_.count;
+        if(nt > 0)
+            std::memcpy(
+                h_.buf + h_.cap - nt,
+                op.end() - nt,
+                nt);
+    }
+
+    // serialize after the last field,
+    // over the final CRLF
+    auto const tab = h_.tab();
+    auto const base =
+        h_.buf + h_.prefix;
+    auto dest = h_.buf + h_.size - 2;
+    std::size_t i = h_.count;
+    for(auto const& f : init)
+    {
+        auto rv = verify_field_value(f.second);
+        if( rv.has_error() )
+        {
+            // restore the final CRLF
+            h_.buf[h_.size - 2] = '\r';
+            h_.buf[h_.size - 1] = '\n';
+            return rv.error();
+        }
+        auto const name = to_string(f.first);
+        auto const value = rv->value;
+        auto& e = tab[i++];
+        e.np = static_cast<offset_type>(
+            dest - base);
+        e.nn = static_cast<
+            offset_type>(name.size());
+        e.vp = static_cast<offset_type>(
+            e.np + name.size() + 1 +
+                ! value.empty());
+        e.vn = static_cast<
+            offset_type>(value.size());
+        e.id = f.first;
+
+        name.copy(dest, name.size());
+        dest += name.size();
+        *dest++ = ':';
+        if(! value.empty())
+        {
+            *dest++ = ' ';
+            value.copy(
+                dest, value.size());
+            if( rv->has_obs_fold )
+                detail::remove_obs_fold(
+                    dest, dest + value.size());
+            dest += value.size();
+        }
+        *dest++ = '\r';
+        *dest++ = '\n';
+    }
+    *dest++ = '\r';
+    *dest++ = '\n';
+
+    // update container and
+    // metadata in one pass
+    auto const count0 = h_.count;
+    h_.count = static_cast<
+        offset_type>(i);
+    h_.size = static_cast<
+        offset_type>(dest - h_.buf);
+    for(i = count0; i < h_.count; ++i)
+    {
+        auto const& e = tab[i];
+        h_.on_insert(e.id, core::string_view(
+            base + e.vp, e.vn));
+    }
+    return {};
+}
+
 std::size_t
 fields_base::
 erase(
@@ -793,10 +942,33 @@ copy_impl(
             return;
         }
     }
-    fields_base tmp(h);
+    fields_base tmp(h, h_.mr);
     tmp.h_.swap(h_);
 }
 
+// move the contents to a buffer of
+// exactly n bytes, if they fit
+void
+fields_base::
+reallocate(
+    std::size_t n)
+{
+    if( n == h_.cap ||
+        n < detail::header::bytes_needed(
+            h_.size, h_.count))
+        return;
+    auto const p = h_.allocate(n);
+    std::memcpy(
+        p, h_.cbuf, h_.size);
+    h_.copy_table(p + n);
+    h_.deallocate(h_.buf, h_.cap);
+    h_.buf = p;
+    h_.cbuf = p;
+    h_.cap = n;
+    if(h_.tc)
+        h_.tc->clear();
+}
+
 void
 fields_base::
 insert_impl_unchecked(
@@ -929,8 +1101,12 @@ erase_impl(
     field id) noexcept
 {
     raw_erase(i);
-    if(id != field::unknown)
-        h_.on_erase(id);
+    if(id == field::unknown)
+        return;
+    // the id set is exact
+    if(h_.find(id) == h_.count)
+        h_.ids.erase(id);
+    h_.on_erase(id);
 }
 
 //------------------------------------------------
@@ -1038,6 +1214,8 @@ raw_erase_n(
             --n;
         }
     }
+    if(h_.find(id) == h_.count)
+        h_.ids.erase(id);
 }
 
 } // http_proto
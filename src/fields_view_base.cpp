@@ -40,6 +40,9 @@ operator*() const noexcept ->
     BOOST_ASSERT(i_ < ph_->count);
     auto tab =
         ph_->tab();
+    // the parser may defer the id
+    if(ph_->lazy)
+        ph_->index();
     auto const& e =
         tab[i_];
     auto const* p =
@@ -63,6 +66,8 @@ operator*() const noexcept ->
     BOOST_ASSERT(i_ > 0);
     auto tab =
       ph_->tab();
+    if(ph_->lazy)
+        ph_->index();
     auto const& e =
         tab[i_-1];
     auto const* p =
@@ -183,7 +188,14 @@ std::size_t
 fields_view_base::
 count(field id) const noexcept
 {
-    std::size_t n = 0;
+    ph_->index(id);
+    if(! ph_->ids.contains(id))
+        return 0;
+    // metadata counts some fields
+    auto n = ph_->maybe_count(id);
+    if(n != std::size_t(-1))
+        return n;
+    n = 0;
     for(auto v : *this)
         if(v.id == id)
             ++n;
@@ -195,6 +207,14 @@ fields_view_base::
 count(
     core::string_view name) const noexcept
 {
+    // string_to_field assumes a token,
+    // so confirm the name before using
+    // its id
+    auto const id = string_to_field(name);
+    if( id != field::unknown &&
+        grammar::ci_is_equal(
+            name, to_string(id)))
+        return count(id);
     std::size_t n = 0;
     for(auto v : *this)
         if(grammar::ci_is_equal(
@@ -208,15 +228,9 @@ fields_view_base::
 find(field id) const noexcept ->
     iterator
 {
-    auto it = begin();
-    auto const last = end();
-    while(it != last)
-    {
-        if(it->id == id)
-            break;
-        ++it;
-    }
-    return it;
+    ph_->index(id);
+    return iterator(
+        ph_, ph_->find(id));
 }
 
 auto
@@ -225,6 +239,14 @@ find(
     core::string_view name) const noexcept ->
     iterator
 {
+    // known names are always stored with
+    // their id, but string_to_field assumes
+    // a token, so confirm the name
+    auto const id = string_to_field(name);
+    if( id != field::unknown &&
+        grammar::ci_is_equal(
+            name, to_string(id)))
+        return find(id);
     auto it = begin();
     auto const last = end();
     while(it != last)
@@ -245,6 +267,9 @@ find(
         iterator
 {
     auto const last = end();
+    ph_->index(id);
+    if(! ph_->ids.contains(id))
+        return last;
     while(from != last)
     {
         if(from->id == id)
@@ -279,6 +304,9 @@ find_last(
     field id) const noexcept ->
         iterator
 {
+    ph_->index(id);
+    if(! ph_->ids.contains(id))
+        return end();
     auto const it0 = begin();
     for(;;)
     {
@@ -30,6 +30,48 @@ file_body(
 {
 }
 
+auto
+file_body::
+data(
+    system::error_code& ec) ->
+        region
+{
+    region r{ f_.native_handle(), 0, 0 };
+    r.offset = f_.pos(ec);
+    if(ec.failed())
+        return r;
+    if(n_ != std::uint64_t(-1))
+    {
+        r.size = n_;
+        return r;
+    }
+    auto const n = f_.size(ec);
+    if(ec.failed())
+        return r;
+    if(n > r.offset)
+        r.size = n - r.offset;
+    return r;
+}
+
+void
+file_body::
+consume(
+    std::uint64_t n,
+    system::error_code& ec)
+{
+    auto const pos = f_.pos(ec);
+    if(ec.failed())
+        return;
+    f_.seek(pos + n, ec);
+    if(ec.failed())
+        return;
+    if(n_ != std::uint64_t(-1))
+    {
+        BOOST_ASSERT(n <= n_);
+        n_ -= n;
+    }
+}
+
 auto
 file_body::
 on_read(
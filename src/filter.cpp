@@ -26,14 +26,43 @@ on_process(
     auto it1 = buffers::begin(out);
     auto const end0 = buffers::end(in);
     auto const end1 = buffers::end(out);
-    while(
-        it0 != end0 ||
-        it1 != end1)
+    buffers::const_buffer b0;
+    buffers::mutable_buffer b1;
+    for(;;)
     {
-        ++it1;
-        (void)more;
-        (void)end0;
-        (void)it0;
+        while(
+            b0.size() == 0 &&
+            it0 != end0)
+            b0 = *it0++;
+        while(
+            b1.size() == 0 &&
+            it1 != end1)
+            b1 = *it1++;
+        // The filter is called even without
+        // output space, so that it can consume
+        // input which produces no output.
+        auto rs = on_process(
+            b1, b0, more || it0 != end0);
+        b0 += rs.in_bytes;
+        b1 += rs.out_bytes;
+        rv.in_bytes += rs.in_bytes;
+        rv.out_bytes += rs.out_bytes;
+        if(rs.ec.failed())
+        {
+            rv.ec = rs.ec;
+            break;
+        }
+        if(rs.finished)
+        {
+            rv.finished = true;
+            break;
+        }
+        if( rs.in_bytes == 0 &&
+            rs.out_bytes == 0)
+        {
+            // no progress
+            break;
+        }
     }
     return rv;
 }
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/mmap_body.hpp>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/buffers/algorithm.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/exchange.hpp>
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace boost {
+namespace http_proto {
+
+constexpr std::size_t mmap_body::default_slice_size;
+
+static
+std::size_t
+page_size() noexcept
+{
+    static std::size_t const n =
+        static_cast<std::size_t>(
+            ::sysconf(_SC_PAGESIZE));
+    return n;
+}
+
+mmap_body::
+mmap_body(
+    mmap_body&& other) noexcept
+    : source(std::move(other))
+    , f_(std::move(other.f_))
+    , pos_(other.pos_)
+    , n_(boost::exchange(other.n_, 0))
+    , slice_(other.slice_)
+    , map_(boost::exchange(other.map_, nullptr))
+    , map_size_(boost::exchange(other.map_size_, 0))
+    , p_(boost::exchange(other.p_, nullptr))
+    , avail_(boost::exchange(other.avail_, 0))
+{
+}
+
+mmap_body::
+~mmap_body()
+{
+    unmap();
+}
+
+mmap_body::
+mmap_body(
+    file_posix&& f,
+    std::uint64_t size,
+    std::size_t slice_size)
+    : f_(std::move(f))
+{
+    system::error_code ec;
+    pos_ = f_.pos(ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+    if(size == std::uint64_t(-1))
+    {
+        auto const n = f_.size(ec);
+        if(ec.failed())
+            detail::throw_system_error(ec);
+        size = n > pos_ ? n - pos_ : 0;
+    }
+    n_ = size;
+
+    auto const page = page_size();
+    if(slice_size < page)
+        slice_size = page;
+    slice_ = (slice_size + page - 1) / page * page;
+}
+
+void
+mmap_body::
+unmap() noexcept
+{
+    if(! map_)
+        return;
+    ::munmap(map_, map_size_);
+    map_ = nullptr;
+    map_size_ = 0;
+}
+
+buffers::const_buffer
+mmap_body::
+data(
+    system::error_code& ec)
+{
+    if( avail_ > 0 ||
+        n_ == 0)
+        return { p_, avail_ };
+
+    // the offset of a mapping
+    // must be page aligned
+    unmap();
+    auto const skip = static_cast<
+        std::size_t>(pos_ % page_size());
+    std::size_t len = slice_;
+    if(n_ < len - skip)
+        len = skip + static_cast<
+            std::size_t>(n_);
+    auto const p = ::mmap(
+        nullptr,
+        len,
+        PROT_READ,
+        MAP_PRIVATE,
+        f_.native_handle(),
+        static_cast<::off_t>(pos_ - skip));
+    if(p == MAP_FAILED)
+    {
+        ec = system::error_code(
+            errno, system::system_category());
+        return {};
+    }
+#ifdef MADV_SEQUENTIAL
+    ::madvise(p, len, MADV_SEQUENTIAL);
+#endif
+    map_ = p;
+    map_size_ = len;
+    p_ = static_cast<char const*>(p) + skip;
+    avail_ = len - skip;
+    return { p_, avail_ };
+}
+
+void
+mmap_body::
+consume(
+    std::size_t n) noexcept
+{
+    BOOST_ASSERT(n <= avail_);
+    p_ += n;
+    avail_ -= n;
+    pos_ += n;
+    n_ -= n;
+}
+
+auto
+mmap_body::
+on_read(
+    buffers::mutable_buffer b) ->
+        results
+{
+    results rv;
+    while( b.size() > 0 &&
+        n_ > 0)
+    {
+        auto const cb = data(rv.ec);
+        if(rv.ec.failed())
+            return rv;
+        auto const n =
+            buffers::buffer_copy(b, cb);
+        consume(n);
+        b += n;
+        rv.bytes += n;
+    }
+    rv.finished = n_ == 0;
+    return rv;
+}
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,360 @@
+//
+// Copyright (c) 2023 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/multipart_sink.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+multipart_sink::
+~multipart_sink() = default;
+
+multipart_sink::
+multipart_sink(
+    multipart_sink&&) noexcept = default;
+
+multipart_sink::
+multipart_sink(
+    core::string_view content_type,
+    header_limits const& lim)
+    : delim_("\r\n--")
+    , lim_(lim)
+    , h_(detail::empty{
+        detail::kind::fields})
+{
+    auto rv = grammar::parse(
+        content_type, media_type_rule);
+    if( ! rv ||
+        ! grammar::ci_is_equal(
+            rv->mime.type, "multipart"))
+        detail::throw_invalid_argument();
+    for(auto const& p : rv->params)
+    {
+        if(! grammar::ci_is_equal(
+                p.name, "boundary"))
+            continue;
+        core::string_view s = p.value;
+        if(s.front() != '\"')
+        {
+            delim_.append(
+                s.data(), s.size());
+            break;
+        }
+        // unquote
+        s = s.substr(1, s.size() - 2);
+        for(auto it = s.begin();
+            it != s.end(); ++it)
+        {
+            if(*it == '\\')
+                ++it;
+            delim_.push_back(*it);
+        }
+        break;
+    }
+
+    // rfc2046 section 5.1.1
+    auto const n = delim_.size() - 4;
+    if( n < 1 || n > 70 ||
+        delim_.back() == ' ')
+        detail::throw_invalid_argument();
+
+    // Horspool skip table, indexed by
+    // the last byte of each window
+    auto const m = delim_.size();
+    std::memset(skip_,
+        static_cast<int>(m), sizeof(skip_));
+    for(std::size_t i = 0; i < m - 1; ++i)
+        skip_[static_cast<unsigned char>(
+            delim_[i])] = static_cast<
+                unsigned char>(m - 1 - i);
+
+    hold_.reserve(2 * m);
+    hbuf_.reset(new char[
+        lim_.valid_space_needed()]);
+
+    // the body may begin with the
+    // delimiter, without the CRLF
+    hold_ = "\r\n";
+}
+
+// Returns the first delimiter in the
+// range, else the first position from
+// which the rest of the range is a
+// prefix of the delimiter, else end.
+char const*
+multipart_sink::
+find(
+    char const* first,
+    char const* last) const noexcept
+{
+    auto const m = delim_.size();
+    auto const n = static_cast<
+        std::size_t>(last - first);
+    auto const back = delim_[m - 1];
+    std::size_t i = 0;
+    while(i + m <= n)
+    {
+        auto const c = first[i + m - 1];
+        if( c == back &&
+            std::memcmp(first + i,
+                delim_.data(), m - 1) == 0)
+            return first + i;
+        i += skip_[static_cast<
+            unsigned char>(c)];
+    }
+    // a skip may pass over the start
+    // of a partial match at the end
+    i = n >= m ? n - (m - 1) : 0;
+    for(; i < n; ++i)
+    {
+        if(std::memcmp(first + i,
+                delim_.data(), n - i) == 0)
+            return first + i;
+    }
+    return last;
+}
+
+// Passes body bytes to the part, up to
+// the next delimiter. Returns the end
+// of the consumed input.
+char const*
+multipart_sink::
+scan(
+    char const* first,
+    char const* last,
+    system::error_code& ec)
+{
+    auto const m = delim_.size();
+    if(! hold_.empty())
+    {
+        // look for a delimiter beginning
+        // in the bytes held from before
+        auto const h = hold_.size();
+        auto k = static_cast<
+            std::size_t>(last - first);
+        if( k > m - 1)
+            k = m - 1;
+        hold_.append(first, k);
+        std::size_t i = 0;
+        for(; i < h; ++i)
+        {
+            auto n = hold_.size() - i;
+            if( n > m)
+                n = m;
+            if(std::memcmp(hold_.data() + i,
+                    delim_.data(), n) == 0)
+                break;
+        }
+        emit(hold_.data(), i, ec);
+        if(ec.failed())
+            return first;
+        if(i == h)
+        {
+            // the input is searched below
+            hold_.clear();
+        }
+        else if(hold_.size() - i >= m)
+        {
+            hold_.clear();
+            end_part(ec);
+            return first + (i + m - h);
+        }
+        else
+        {
+            // still a partial match, which
+            // takes all of the input
+            hold_.erase(0, i);
+            return last;
+        }
+    }
+
+    auto const it = find(first, last);
+    emit(first, static_cast<
+        std::size_t>(it - first), ec);
+    if(ec.failed())
+        return first;
+    if(static_cast<std::size_t>(
+        last - it) >= m)
+    {
+        end_part(ec);
+        return it + m;
+    }
+    hold_.assign(it, last);
+    return last;
+}
+
+void
+multipart_sink::
+emit(
+    char const* p,
+    std::size_t n,
+    system::error_code& ec)
+{
+    if( n == 0 ||
+        part_ == nullptr ||
+        st_ != state::body)
+        return;
+    ec = part_->write(
+        buffers::const_buffer(p, n),
+            true).ec;
+}
+
+void
+multipart_sink::
+end_part(
+    system::error_code& ec)
+{
+    if(st_ == state::body)
+    {
+        if(part_)
+            ec = part_->write(
+                buffers::const_buffer(),
+                    false).ec;
+        part_ = nullptr;
+    }
+    st_ = state::delim;
+}
+
+void
+multipart_sink::
+start_header() noexcept
+{
+    h_ = detail::header(
+        detail::empty{
+            detail::kind::fields});
+    h_.buf = hbuf_.get();
+    h_.cbuf = h_.buf;
+    h_.cap = lim_.valid_space_needed();
+    hn_ = 0;
+}
+
+auto
+multipart_sink::
+on_write(
+    buffers::const_buffer b,
+    bool more) ->
+        results
+{
+    results rv;
+    auto const first = static_cast<
+        char const*>(b.data());
+    auto const last = first + b.size();
+    auto p = first;
+    while(p != last)
+    {
+        switch(st_)
+        {
+        case state::preamble:
+        case state::body:
+            p = scan(p, last, rv.ec);
+            break;
+
+        // after the boundary: "--" for the
+        // close delimiter, else optional
+        // whitespace and CRLF
+        case state::delim:
+            if(*p == '-')
+            {
+                ++p;
+                st_ = state::close;
+                break;
+            }
+            st_ = state::padding;
+            break;
+
+        case state::close:
+            if(*p != '-')
+            {
+                rv.ec = BOOST_HTTP_PROTO_ERR(
+                    error::bad_multipart);
+                break;
+            }
+            ++p;
+            st_ = state::epilogue;
+            break;
+
+        case state::padding:
+            if( *p == ' ' ||
+                *p == '\t')
+            {
+                ++p;
+                break;
+            }
+            if(*p != '\r')
+            {
+                rv.ec = BOOST_HTTP_PROTO_ERR(
+                    error::bad_multipart);
+                break;
+            }
+            ++p;
+            st_ = state::lf;
+            break;
+
+        case state::lf:
+            if(*p != '\n')
+            {
+                rv.ec = BOOST_HTTP_PROTO_ERR(
+                    error::bad_multipart);
+                break;
+            }
+            ++p;
+            start_header();
+            st_ = state::header;
+            break;
+
+        case state::header:
+        {
+            auto n = static_cast<
+                std::size_t>(last - p);
+            if( n > lim_.max_size - hn_)
+                n = lim_.max_size - hn_;
+            std::memcpy(h_.buf + hn_, p, n);
+            auto const hn0 = hn_;
+            hn_ += n;
+            h_.parse(hn_, lim_, rv.ec);
+            if(rv.ec == condition::need_more_input)
+            {
+                rv.ec = {};
+                p += n;
+                break;
+            }
+            if(rv.ec.failed())
+                break;
+            p += h_.size - hn0;
+            ++n_;
+            st_ = state::body;
+            part_ = on_part(fields_view(&h_));
+            break;
+        }
+
+        case state::epilogue:
+            p = last;
+            break;
+        }
+        if(rv.ec.failed())
+            break;
+    }
+    rv.bytes = static_cast<
+        std::size_t>(p - first);
+    if( ! rv.ec.failed() &&
+        ! more &&
+        st_ != state::epilogue)
+        rv.ec = BOOST_HTTP_PROTO_ERR(
+            error::incomplete);
+    return rv;
+}
+
+} // http_proto
+} // boost
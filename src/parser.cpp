@@ -10,11 +10,19 @@
 #include <boost/http_proto/parser.hpp>
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/error.hpp>
+#include <boost/http_proto/service/brotli_service.hpp>
 #include <boost/http_proto/service/zlib_service.hpp>
 #include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/buffers/algorithm.hpp>
 #include <boost/buffers/buffer_copy.hpp>
 #include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
 #include <boost/assert.hpp>
+#include "detail/workspace_pool.hpp"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 namespace boost {
@@ -110,9 +118,12 @@ class parser_service
 public:
     parser::config_base cfg;
     std::size_t space_needed = 0;
+    std::size_t header_space = 0;
     std::size_t max_codec = 0;
     zlib::deflate_decoder_service const*
         deflate_svc = nullptr;
+    brotli::decoder_service const*
+        brotli_svc = nullptr;
 
     parser_service(
         context& ctx,
@@ -167,6 +178,13 @@ parser_service(
     space_needed +=
         cfg.headers.valid_space_needed();
 
+    // fb_ and the largest table, which
+    // must fit past the start of a
+    // header parsed in place
+    header_space =
+        cfg.headers.valid_space_needed() +
+        cfg.min_buffer;
+
     // cb0_, cb1_
     // VFALCO OVERFLOW CHECKING ON THIS
     space_needed +=
@@ -187,6 +205,16 @@ parser_service(
             if( max_codec < n)
                 max_codec = n;
         }
+
+        if(cfg.apply_brotli_decoder)
+        {
+            brotli_svc = &ctx.get_service<
+                brotli::decoder_service>();
+            auto const n =
+                brotli_svc->space_needed();
+            if( max_codec < n)
+                max_codec = n;
+        }
     }
     space_needed += max_codec;
 
@@ -206,6 +234,303 @@ install_parser_service(
         parser_service>(cfg);
 }
 
+//------------------------------------------------
+//
+// Chunked
+//
+//------------------------------------------------
+
+namespace detail {
+
+/*  A forward-only cursor over both halves
+    of a circular buffer. This lets the chunk
+    grammar be walked directly on the input
+    without first making it contiguous.
+*/
+class chained_sequence
+{
+    char const* pos_;
+    char const* end_;
+    char const* begin_b_;
+    char const* end_b_;
+
+    void
+    swap_ranges() noexcept
+    {
+        pos_ = begin_b_;
+        end_ = end_b_;
+        begin_b_ = end_b_;
+    }
+
+public:
+    explicit
+    chained_sequence(
+        buffers::const_buffer_pair const& cbp) noexcept
+        : pos_(static_cast<
+            char const*>(cbp[0].data()))
+        , end_(pos_ + cbp[0].size())
+        , begin_b_(static_cast<
+            char const*>(cbp[1].data()))
+        , end_b_(begin_b_ + cbp[1].size())
+    {
+        if(pos_ == end_)
+            swap_ranges();
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return pos_ == end_;
+    }
+
+    char
+    value() const noexcept
+    {
+        BOOST_ASSERT(! empty());
+        return *pos_;
+    }
+
+    // number of octets remaining
+    std::size_t
+    size() const noexcept
+    {
+        return
+            static_cast<std::size_t>(end_ - pos_) +
+            static_cast<std::size_t>(end_b_ - begin_b_);
+    }
+
+    void
+    next() noexcept
+    {
+        BOOST_ASSERT(! empty());
+        if(++pos_ == end_)
+            swap_ranges();
+    }
+};
+
+} // detail
+
+// chunk-size = 1*HEXDIG
+static
+system::result<std::uint64_t>
+parse_hex(
+    detail::chained_sequence& cs) noexcept
+{
+    std::uint64_t v = 0;
+    auto const n0 = cs.size();
+    while(! cs.empty())
+    {
+        auto const d =
+            grammar::hexdig_value(cs.value());
+        if(d < 0)
+        {
+            if(cs.size() == n0)
+            {
+                // missing chunk-size
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    error::bad_payload);
+            }
+            return v;
+        }
+        if(v > (std::uint64_t(-1) >> 4))
+        {
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::numeric_overflow);
+        }
+        v = (v << 4) | static_cast<
+            std::uint64_t>(d);
+        cs.next();
+    }
+    BOOST_HTTP_PROTO_RETURN_EC(
+        error::need_data);
+}
+
+// CRLF
+static
+system::error_code
+parse_eol(
+    detail::chained_sequence& cs) noexcept
+{
+    if(cs.empty())
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::need_data);
+    if(cs.value() != '\r')
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::bad_payload);
+    cs.next();
+    if(cs.empty())
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::need_data);
+    if(cs.value() != '\n')
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::bad_payload);
+    cs.next();
+    return {};
+}
+
+// BWS = *( SP / HTAB )
+static
+void
+skip_bws(
+    detail::chained_sequence& cs) noexcept
+{
+    while(
+        ! cs.empty() &&
+        detail::ws(cs.value()))
+        cs.next();
+}
+
+// returns the number of tchars skipped
+static
+std::size_t
+skip_token(
+    detail::chained_sequence& cs) noexcept
+{
+    auto const n0 = cs.size();
+    while(
+        ! cs.empty() &&
+        tchars(cs.value()))
+        cs.next();
+    return n0 - cs.size();
+}
+
+/*  Skips the extensions on a chunk-size
+    line, stopping just before the CRLF.
+
+    chunk-ext      = *( BWS ";" BWS chunk-ext-name
+                        [ BWS "=" BWS chunk-ext-val ] )
+    chunk-ext-name = token
+    chunk-ext-val  = token / quoted-string
+*/
+static
+system::error_code
+skip_chunk_ext(
+    detail::chained_sequence& cs) noexcept
+{
+    for(;;)
+    {
+        skip_bws(cs);
+        if(cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        if(cs.value() != ';')
+            return {};
+        cs.next();
+
+        // chunk-ext-name
+        skip_bws(cs);
+        if( skip_token(cs) == 0 &&
+            ! cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::bad_payload);
+        skip_bws(cs);
+        if(cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        if(cs.value() != '=')
+            continue;
+        cs.next();
+
+        // chunk-ext-val
+        skip_bws(cs);
+        if(cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        if(cs.value() != '"')
+        {
+            if(skip_token(cs) == 0)
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    error::bad_payload);
+            continue;
+        }
+
+        // quoted-string
+        cs.next();
+        for(;;)
+        {
+            if(cs.empty())
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    error::need_data);
+            auto const c = static_cast<
+                unsigned char>(cs.value());
+            cs.next();
+            if(c == '"')
+                break;
+            if(c == '\\')
+            {
+                // quoted-pair
+                if(cs.empty())
+                    BOOST_HTTP_PROTO_RETURN_EC(
+                        error::need_data);
+                auto const c2 = static_cast<
+                    unsigned char>(cs.value());
+                if( ! detail::ws_vchars(cs.value()) &&
+                    c2 < 0x80)
+                    BOOST_HTTP_PROTO_RETURN_EC(
+                        error::bad_payload);
+                cs.next();
+                continue;
+            }
+            // qdtext
+            if( ! detail::ws_vchars(
+                    static_cast<char>(c)) &&
+                c < 0x80)
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    error::bad_payload);
+        }
+    }
+}
+
+/*  Skips the trailer section which follows
+    the last-chunk, including the final CRLF.
+
+    trailer-section = *( field-line CRLF )
+    field-line      = field-name ":" OWS field-value OWS
+*/
+static
+system::error_code
+skip_trailer_headers(
+    detail::chained_sequence& cs) noexcept
+{
+    for(;;)
+    {
+        if(cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        if(cs.value() == '\r')
+            return parse_eol(cs);
+
+        // field-name
+        if(skip_token(cs) == 0)
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::bad_field_name);
+        if(cs.empty())
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        if(cs.value() != ':')
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::bad_field_name);
+        cs.next();
+
+        // field-value
+        while(! cs.empty())
+        {
+            auto const c = cs.value();
+            if( ! detail::ws_vchars(c) &&
+                static_cast<
+                    unsigned char>(c) < 0x80)
+                break;
+            cs.next();
+        }
+        auto ec = parse_eol(cs);
+        if(ec == error::bad_payload)
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::bad_field_value);
+        if(ec.failed())
+            return ec;
+    }
+}
+
 //------------------------------------------------
 //
 // Special Members
@@ -220,12 +545,19 @@ parser(
     , svc_(ctx.get_service<
         parser_service>())
     , h_(detail::empty{k})
+    , trailers_(detail::empty{
+        detail::kind::fields})
     , eb_(nullptr)
     , st_(state::reset)
 {
     auto const n =
         svc_.space_needed;
-    ws_.allocate(n);
+    auto const pool = ctx.find_service<
+        detail::workspace_pool>();
+    if(pool)
+        ws_.allocate(n, *pool);
+    else
+        ws_.allocate(n);
     h_.cap = n;
 }
 
@@ -248,6 +580,7 @@ parser::
 reset() noexcept
 {
     ws_.clear();
+    ws_.release();
     eb_ = nullptr;
     st_ = state::start;
     got_eof_ = false;
@@ -259,6 +592,7 @@ start_impl(
     bool head_response)
 {
     std::size_t leftover = 0;
+    std::size_t offset = 0;
     switch(st_)
     {
     default:
@@ -291,22 +625,42 @@ start_impl(
         if(body_buf_ == &cb0_)
             cb0_.consume(static_cast<std::size_t>(body_avail_));
 
-        if(cb0_.size() > 0)
+        // octets past the end of the message
+        // are the start of the next one
+        leftover = cb0_.size();
+        if(leftover == 0)
+            break;
+
+        ws_.clear();
+        auto const base = ws_.data();
+        auto const cbp = cb0_.data();
+        offset = static_cast<
+            unsigned char const*>(
+                cbp[0].data()) - base;
+        if(cbp[1].size() > 0)
         {
-            // headers with no body
-            BOOST_ASSERT(h_.size > 0);
-            fb_.consume(h_.size);
-            leftover = fb_.size();
-            // move unused octets to front
-            buffers::buffer_copy(
-                buffers::mutable_buffer(
-                    ws_.data(),
-                    leftover),
-                fb_.data());
+            // the octets wrap around, so
+            // rotate them into one piece
+            auto const first = base + offset;
+            offset = static_cast<
+                unsigned char const*>(
+                    cbp[1].data()) - base;
+            std::rotate(
+                base + offset,
+                first,
+                first + cbp[0].size());
         }
-        else
+
+        // parse the next header where it lies,
+        // unless the space past it is too small
+        if(offset + svc_.header_space >
+            ws_.size())
         {
-            // leftover data after body
+            std::memmove(
+                base,
+                base + offset,
+                leftover);
+            offset = 0;
         }
         break;
     }
@@ -314,20 +668,35 @@ start_impl(
 
     ws_.clear();
 
-    fb_ = {
-        ws_.data(),
-        svc_.cfg.headers.max_size +
-            svc_.cfg.min_buffer,
-        leftover };
-    BOOST_ASSERT(fb_.capacity() ==
-        svc_.max_overread());
+    // storage from a pool is returned while
+    // waiting for the next message, unless
+    // pipelined data must be kept
+    if(leftover == 0)
+        ws_.release();
 
     h_ = detail::header(
         detail::empty{h_.kind});
-    h_.buf = reinterpret_cast<
-        char*>(ws_.data());
-    h_.cbuf = h_.buf;
-    h_.cap = ws_.size();
+    if(svc_.cfg.lazy_fields)
+    {
+        lazy_.store(
+            detail::header::lazy_pending,
+            std::memory_order_relaxed);
+        h_.lazy = &lazy_;
+    }
+    if(h_.kind == detail::kind::request)
+    {
+        tc_.clear();
+        h_.tc = &tc_;
+    }
+    trailers_ = detail::header(
+        detail::empty{
+            detail::kind::fields});
+    if(offset > 0)
+        ws_.reserve_front(offset);
+    if(ws_.has_storage())
+        init_header(leftover);
+    else
+        fb_ = {};
 
     BOOST_ASSERT(! head_response ||
         h_.kind == detail::kind::response);
@@ -339,6 +708,29 @@ start_impl(
     nprepare_ = 0;
 }
 
+// lay out the buffer for the header, with
+// octets left over from the previous message
+// at the front. The header may start past
+// the beginning of the workspace.
+void
+parser::
+init_header(
+    std::size_t leftover)
+{
+    fb_ = {
+        ws_.data(),
+        svc_.cfg.headers.max_size +
+            svc_.cfg.min_buffer,
+        leftover };
+    BOOST_ASSERT(fb_.capacity() ==
+        svc_.max_overread());
+
+    h_.buf = reinterpret_cast<
+        char*>(ws_.data());
+    h_.cbuf = h_.buf;
+    h_.cap = ws_.size();
+}
+
 auto
 parser::
 prepare() ->
@@ -359,6 +751,11 @@ prepare() ->
 
     case state::header:
     {
+        if(! ws_.has_storage())
+        {
+            ws_.acquire();
+            init_header(0);
+        }
         BOOST_ASSERT(h_.size <
             svc_.cfg.headers.max_size);
         auto n = fb_.capacity() - fb_.size();
@@ -380,8 +777,14 @@ prepare() ->
         if(! is_plain())
         {
             // buffered payload
-            auto n = cb0_.capacity() -
-                cb0_.size();
+            if(chunked_body_ended_)
+            {
+                // the message is received, and
+                // any trailers lie in the free
+                // space of cb0_
+                return mutable_buffers_type{};
+            }
+            auto n = cb0_.capacity();
             if( n > svc_.cfg.max_prepare)
                 n = svc_.cfg.max_prepare;
             mbp_ = cb0_.prepare(n);
@@ -391,7 +794,8 @@ prepare() ->
 
         // plain payload
 
-        if(how_ == how::in_place)
+        if( how_ == how::in_place ||
+            how_ == how::pull)
         {
             auto n =
                 body_buf_->capacity() -
@@ -468,17 +872,18 @@ prepare() ->
             return eb_->prepare(n);
         }
 
-        // VFALCO TODO
-        if(how_ == how::pull)
-            detail::throw_logic_error();
-
         // VFALCO TODO
         detail::throw_logic_error();
     }
 
     case state::set_body:
     {
-        BOOST_ASSERT(is_plain());
+        if(! is_plain())
+        {
+            // parse() transfers the decoded
+            // in-place body into the set body
+            return mutable_buffers_type{};
+        }
 
         if(how_ == how::elastic)
         {
@@ -578,20 +983,24 @@ commit(
 
         // plain payload
 
-        if(how_ == how::in_place)
+        if( how_ == how::in_place ||
+            how_ == how::pull)
         {
+            // pull_some may have consumed
+            // part of the body already
             BOOST_ASSERT(body_buf_ == &cb0_);
             cb0_.commit(n);
             if(h_.md.payload == payload::size)
             {
-                if(cb0_.size() <
-                    h_.md.payload_size)
+                if(n < payload_remain_)
                 {
                     body_avail_ += n;
+                    body_total_ += n;
                     payload_remain_ -= n;
                     break;
                 }
-                body_avail_ = h_.md.payload_size;
+                body_avail_ += payload_remain_;
+                body_total_ += payload_remain_;
                 payload_remain_ = 0;
                 st_ = state::complete;
                 break;
@@ -600,6 +1009,7 @@ commit(
             BOOST_ASSERT(
                 h_.md.payload == payload::to_eof);
             body_avail_ += n;
+            body_total_ += n;
             break;
         }
 
@@ -638,12 +1048,6 @@ commit(
             cb0_.commit(n);
             break;
         }
-
-        if(how_ == how::pull)
-        {
-            // VFALCO TODO
-            detail::throw_logic_error();
-        }
         break;
     }
 
@@ -656,7 +1060,6 @@ commit(
             detail::throw_invalid_argument();
         }
 
-        BOOST_ASSERT(is_plain());
         BOOST_ASSERT(n == 0);
         if( how_ == how::elastic ||
             how_ == how::sink)
@@ -744,6 +1147,11 @@ parse(
 
     case state::header:
     {
+        if(! ws_.has_storage())
+        {
+            ws_.acquire();
+            init_header(0);
+        }
         BOOST_ASSERT(h_.buf == static_cast<
             void const*>(ws_.data()));
         BOOST_ASSERT(h_.cbuf == static_cast<
@@ -802,25 +1210,356 @@ parse(
             h_.md.payload != payload::none);
         BOOST_ASSERT(
             h_.md.payload != payload::error);
-        if(h_.md.payload == payload::chunked)
-        {
-            // VFALCO parse chunked
-            detail::throw_logic_error();
-        }
-        else if(filt_)
+        if(! is_plain())
         {
-            // VFALCO TODO apply filter
-            detail::throw_logic_error();
+            // buffered payload
+            for(;;)
+            {
+                if( h_.md.payload == payload::chunked &&
+                    chunk_remain_ == 0 &&
+                    ! chunked_body_ended_)
+                {
+                    // Nothing is consumed until the
+                    // complete chunk header is present,
+                    // so a header split across calls to
+                    // commit is simply parsed again.
+                    detail::chained_sequence cs(
+                        cb0_.data());
+                    auto const n0 = cs.size();
+                    std::uint64_t chunk_size = 0;
+                    if(needs_chunk_close_)
+                        ec = parse_eol(cs);
+                    if(! ec.failed())
+                    {
+                        auto rv = parse_hex(cs);
+                        if(rv.has_value())
+                            chunk_size = *rv;
+                        else
+                            ec = rv.error();
+                    }
+                    if(! ec.failed())
+                        ec = skip_chunk_ext(cs);
+                    if(! ec.failed())
+                        ec = parse_eol(cs);
+                    // octets before the trailer section
+                    std::size_t n1 = 0;
+                    if( ! ec.failed() &&
+                        chunk_size == 0)
+                    {
+                        n1 = n0 - cs.size();
+                        ec = skip_trailer_headers(cs);
+                    }
+                    if(ec == condition::need_more_input)
+                    {
+                        if(got_eof_)
+                        {
+                            ec = BOOST_HTTP_PROTO_ERR(
+                                error::incomplete);
+                            st_ = state::reset; // unrecoverable
+                            return;
+                        }
+                        if(cb0_.capacity() == 0)
+                        {
+                            // chunk header or trailer
+                            // section cannot fit
+                            ec = BOOST_HTTP_PROTO_ERR(
+                                error::bad_payload);
+                            st_ = state::reset; // unrecoverable
+                            return;
+                        }
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::need_data);
+                        return;
+                    }
+                    if(ec.failed())
+                    {
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    // with a filter, the limit
+                    // applies to the decoded body
+                    if( ! filt_ &&
+                        chunk_size >
+                            svc_.cfg.body_limit - body_total_)
+                    {
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::body_too_large);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if( chunk_size == 0 &&
+                        n0 - cs.size() - n1 > 2)
+                    {
+                        on_trailers(n1,
+                            n0 - cs.size() - n1, ec);
+                        if(ec.failed())
+                        {
+                            st_ = state::reset; // unrecoverable
+                            return;
+                        }
+                    }
+                    cb0_.consume(n0 - cs.size());
+                    chunk_remain_ = chunk_size;
+                    needs_chunk_close_ = chunk_size != 0;
+                    chunked_body_ended_ = chunk_size == 0;
+                }
+
+                // n is the payload in cb0_, and
+                // payload_done is true when no
+                // payload follows those n bytes.
+                auto n = cb0_.size();
+                bool payload_done;
+                switch(h_.md.payload)
+                {
+                default:
+                case payload::chunked:
+                    if( n > chunk_remain_)
+                        n = static_cast<
+                            std::size_t>(chunk_remain_);
+                    payload_done = chunked_body_ended_;
+                    break;
+
+                case payload::size:
+                    if( n > payload_remain_)
+                        n = static_cast<
+                            std::size_t>(payload_remain_);
+                    payload_done = n == payload_remain_;
+                    break;
+
+                case payload::to_eof:
+                    payload_done = got_eof_;
+                    break;
+                }
+
+                if( filt_ &&
+                    filter_done_ &&
+                    n != 0)
+                {
+                    // payload continues past the
+                    // end of the encoded stream
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::bad_payload);
+                    st_ = state::reset; // unrecoverable
+                    return;
+                }
+
+                if( payload_done &&
+                    n == 0 &&
+                    (! filt_ || filter_done_))
+                {
+                    if(how_ == how::sink)
+                    {
+                        auto rv = sink_->write(
+                            buffers::const_buffer{}, false);
+                        if(rv.ec.failed())
+                        {
+                            ec = rv.ec;
+                            st_ = state::reset; // unrecoverable
+                            return;
+                        }
+                    }
+                    st_ = state::complete;
+                    return;
+                }
+
+                if( n == 0 &&
+                    (! filt_ || filter_done_))
+                {
+                    if(got_eof_)
+                    {
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::incomplete);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::need_data);
+                    return;
+                }
+
+                if(filt_)
+                {
+                    // decoded payload
+                    std::size_t space = 0;
+                    filter::results rs;
+                    if(how_ == how::elastic)
+                    {
+                        space =
+                            eb_->max_size() - eb_->size();
+                        auto m =
+                            eb_->capacity() - eb_->size();
+                        if( m < svc_.cfg.min_buffer)
+                            m = svc_.cfg.min_buffer;
+                        if( m > space)
+                            m = space;
+                        rs = filt_->process(
+                            eb_->prepare(m),
+                            buffers::prefix(cb0_.data(), n),
+                            ! payload_done);
+                        eb_->commit(rs.out_bytes);
+                    }
+                    else
+                    {
+                        BOOST_ASSERT(body_buf_ == &cb1_);
+                        rs = filt_->process(
+                            cb1_.prepare(cb1_.capacity()),
+                            buffers::prefix(cb0_.data(), n),
+                            ! payload_done);
+                        cb1_.commit(rs.out_bytes);
+                        body_avail_ += rs.out_bytes;
+                    }
+                    cb0_.consume(rs.in_bytes);
+                    if(h_.md.payload == payload::chunked)
+                        chunk_remain_ -= rs.in_bytes;
+                    else if(h_.md.payload == payload::size)
+                        payload_remain_ -= rs.in_bytes;
+                    body_total_ += rs.out_bytes;
+                    if(rs.ec.failed())
+                    {
+                        ec = rs.ec;
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if(body_total_ > svc_.cfg.body_limit)
+                    {
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::body_too_large);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if( how_ == how::sink &&
+                        cb1_.size() > 0)
+                    {
+                        auto rv = sink_->write(
+                            cb1_.data(), true);
+                        cb1_.consume(rv.bytes);
+                        body_avail_ -= rv.bytes;
+                        if(rv.ec.failed())
+                        {
+                            ec = rv.ec;
+                            st_ = state::reset; // unrecoverable
+                            return;
+                        }
+                    }
+                    if(rs.finished)
+                    {
+                        filter_done_ = true;
+                        continue;
+                    }
+                    if( rs.in_bytes != 0 ||
+                        rs.out_bytes != 0)
+                        continue;
+
+                    // no progress
+                    if( how_ == how::elastic &&
+                        space == 0)
+                    {
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::buffer_overflow);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if( (how_ == how::in_place ||
+                            how_ == how::pull) &&
+                        cb1_.capacity() == 0)
+                    {
+                        // in_place buffer limit
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::in_place_overflow);
+                        return;
+                    }
+                    if( payload_done ||
+                        got_eof_)
+                    {
+                        // encoded stream is truncated
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::incomplete);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::need_data);
+                    return;
+                }
+
+                // chunk-data
+                switch(how_)
+                {
+                default:
+                case how::in_place:
+                case how::pull:
+                {
+                    BOOST_ASSERT(body_buf_ == &cb1_);
+                    if(cb1_.capacity() == 0)
+                    {
+                        // in_place buffer limit
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::in_place_overflow);
+                        return;
+                    }
+                    if( n > cb1_.capacity())
+                        n = cb1_.capacity();
+                    cb1_.commit(
+                        buffers::buffer_copy(
+                            cb1_.prepare(n),
+                            cb0_.data()));
+                    body_avail_ += n;
+                    break;
+                }
+
+                case how::elastic:
+                {
+                    auto const space =
+                        eb_->max_size() - eb_->size();
+                    if(space == 0)
+                    {
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::buffer_overflow);
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if( n > space)
+                        n = space;
+                    eb_->commit(
+                        buffers::buffer_copy(
+                            eb_->prepare(n),
+                            cb0_.data()));
+                    break;
+                }
+
+                case how::sink:
+                {
+                    auto rv = sink_->write(
+                        buffers::prefix(
+                            cb0_.data(), n), true);
+                    n = rv.bytes;
+                    if(rv.ec.failed())
+                    {
+                        cb0_.consume(n);
+                        chunk_remain_ -= n;
+                        body_total_ += n;
+                        ec = rv.ec;
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    break;
+                }
+                }
+
+                cb0_.consume(n);
+                chunk_remain_ -= n;
+                body_total_ += n;
+            }
         }
 
-        if(how_ == how::in_place)
+        if( how_ == how::in_place ||
+            how_ == how::pull)
         {
             BOOST_ASSERT(body_avail_ ==
                 body_buf_->size());
             if(h_.md.payload == payload::size)
             {
-                if(body_avail_ <
-                    h_.md.payload_size)
+                if(payload_remain_ > 0)
                 {
                     if(got_eof_)
                     {
@@ -840,20 +1579,19 @@ parse(
                         error::need_data);
                     return;
                 }
-                BOOST_ASSERT(body_avail_ ==
+                BOOST_ASSERT(body_total_ ==
                     h_.md.payload_size);
                 st_ = state::complete;
                 break;
             }
-            if(body_avail_ > svc_.cfg.body_limit)
+            if(body_total_ > svc_.cfg.body_limit)
             {
                 ec = BOOST_HTTP_PROTO_ERR(
                     error::body_too_large);
                 st_ = state::reset; // unrecoverable
                 return;
             }
-            if( h_.md.payload == payload::chunked ||
-                ! got_eof_)
+            if(! got_eof_)
             {
                 ec = BOOST_HTTP_PROTO_ERR(
                     error::need_data);
@@ -919,7 +1657,51 @@ parse(
 
     case state::set_body:
     {
-        BOOST_ASSERT(is_plain());
+        if(! is_plain())
+        {
+            // transfer the decoded in_place
+            // body into the set body
+            BOOST_ASSERT(body_buf_ == &cb1_);
+            BOOST_ASSERT(
+                body_avail_ == cb1_.size());
+            if(how_ == how::elastic)
+            {
+                if(eb_->max_size() - eb_->size() <
+                    body_avail_)
+                {
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::buffer_overflow);
+                    st_ = state::reset; // unrecoverable
+                    return;
+                }
+                eb_->commit(
+                    buffers::buffer_copy(
+                        eb_->prepare(static_cast<
+                            std::size_t>(body_avail_)),
+                        cb1_.data()));
+                cb1_.consume(static_cast<
+                    std::size_t>(body_avail_));
+                body_avail_ = 0;
+            }
+            else
+            {
+                BOOST_ASSERT(how_ == how::sink);
+                // the body loop delivers the
+                // final write to the sink
+                auto rv = sink_->write(
+                    cb1_.data(), true);
+                cb1_.consume(rv.bytes);
+                body_avail_ -= rv.bytes;
+                if(rv.ec.failed())
+                {
+                    ec = rv.ec;
+                    st_ = state::reset; // unrecoverable
+                    return;
+                }
+            }
+            st_ = state::body;
+            goto do_body;
+        }
 
         // transfer in_place data into set body
 
@@ -1032,8 +1814,9 @@ parse(
         }
 
         case how::pull:
-            // VFALCO TODO
-            detail::throw_logic_error();
+            // the caller drains the
+            // buffer with pull_some
+            break;
         }
     }
     }
@@ -1046,7 +1829,23 @@ parser::
 pull_some() ->
     const_buffers_type
 {
-    return {};
+    // headers must be received
+    if(! got_header())
+        detail::throw_logic_error();
+
+    // a body was attached
+    if( how_ != how::in_place &&
+        how_ != how::pull)
+        detail::throw_logic_error();
+
+    how_ = how::pull;
+    auto const n = static_cast<
+        std::size_t>(body_avail_);
+    cbp_ = buffers::prefix(
+        body_buf_->data(), n);
+    body_buf_->consume(n);
+    body_avail_ = 0;
+    return const_buffers_type(cbp_);
 }
 
 core::string_view
@@ -1080,6 +1879,17 @@ body() const noexcept
     }
 }
 
+fields_view
+parser::
+trailers() const
+{
+    // message must be complete
+    if(st_ != state::complete)
+        detail::throw_logic_error();
+
+    return fields_view(&trailers_);
+}
+
 core::string_view
 parser::
 release_buffered_data() noexcept
@@ -1138,6 +1948,21 @@ on_headers(
         return;
     }
 
+    // A header parsed in place past the start
+    // of the workspace leaves too little room
+    // for the body buffers, so move it and
+    // the overread to the front.
+    if( h_.md.payload != payload::none &&
+        ! head_response_ &&
+        h_.cap < svc_.space_needed)
+    {
+        auto const n = fb_.size();
+        ws_.clear();
+        std::memmove(
+            ws_.data(), h_.cbuf, n);
+        init_header(n);
+    }
+
     // reserve headers + table
     ws_.reserve_front(h_.size);
     ws_.reserve_back(h_.table_space());
@@ -1159,7 +1984,22 @@ on_headers(
     }
 
     // calculate filter
-    filt_ = nullptr; // VFALCO TODO
+    filt_ = nullptr;
+    {
+        // a transfer-coding is applied
+        // after any content-coding
+        auto e = h_.md.transfer_encoding.encoding;
+        if(e == encoding::identity)
+            e = h_.md.content_encoding.encoding;
+        if( svc_.deflate_svc && (
+            e == encoding::deflate ||
+            e == encoding::gzip))
+            filt_ = &svc_.deflate_svc->make_filter(ws_);
+        else if(
+            svc_.brotli_svc &&
+            e == encoding::br)
+            filt_ = &svc_.brotli_svc->make_filter(ws_);
+    }
 
     if(is_plain())
     {
@@ -1228,9 +2068,83 @@ on_headers(
     body_buf_ = &cb1_;
     body_avail_ = 0;
     body_total_ = 0;
+    if(h_.md.payload == payload::size)
+        payload_remain_ = h_.md.payload_size;
+    chunk_remain_ = 0;
+    needs_chunk_close_ = false;
+    chunked_body_ended_ = false;
+    filter_done_ = false;
     st_ = state::body;
 }
 
+/*  Called when the trailer section of `n`
+    octets, starting `pos` octets into cb0_,
+    is received. The input is moved to the
+    start of the storage for cb0_, and the
+    fields are indexed in place, with the
+    table at the end of that storage.
+*/
+void
+parser::
+on_trailers(
+    std::size_t pos,
+    std::size_t n,
+    system::error_code& ec)
+{
+    BOOST_ASSERT(
+        h_.md.payload == payload::chunked);
+    auto const base = ws_.data();
+    auto const size = cb0_.size();
+    auto const cap = size + cb0_.capacity();
+    auto const cbp = cb0_.data();
+    auto const first = static_cast<
+        unsigned char const*>(
+            cbp[0].data()) - base;
+    if(cbp[1].size() > 0)
+    {
+        // the octets wrap around
+        std::rotate(
+            base,
+            base + first,
+            base + cap);
+    }
+    else if(first > 0)
+    {
+        std::memmove(
+            base,
+            base + first,
+            size);
+    }
+    cb0_ = { base, cap, size };
+
+    // the table grows down from the
+    // aligned end of the storage, and
+    // may not reach the received input
+    auto const al = alignof(
+        detail::header::entry);
+    auto const end = cap - (
+        reinterpret_cast<std::uintptr_t>(
+            base + cap) % al);
+    auto const s = reinterpret_cast<
+        char*>(base + pos);
+    if( end < size ||
+        detail::header::table_space(
+            detail::header::count_crlf(
+                core::string_view(s, n))) >
+                    end - size)
+    {
+        ec = BOOST_HTTP_PROTO_ERR(
+            error::fields_limit);
+        return;
+    }
+
+    trailers_.buf = s;
+    trailers_.cbuf = s;
+    trailers_.cap = end - pos;
+    trailers_.parse(
+        n, svc_.cfg.headers, ec);
+}
+
 // Called at the end of set_body
 void
 parser::
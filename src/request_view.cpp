@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/detail/target_cache.hpp>
+#include <boost/url/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+system::result<urls::url_view>
+request_view::
+target_url() const noexcept
+{
+    auto const t = target_text();
+    auto const tc = ph_->tc;
+    if( tc &&
+        tc->state.load(
+            std::memory_order_acquire) ==
+                detail::target_cache::ready &&
+        tc->p == t.data() &&
+        tc->n == t.size())
+    {
+        if(tc->ec.failed())
+            return tc->ec;
+        return tc->u;
+    }
+
+    auto rv = ( ! t.empty() &&
+        t.front() == '/') ?
+            urls::parse_origin_form(t) :
+            urls::parse_absolute_uri(t);
+    unsigned char expected =
+        detail::target_cache::empty;
+    if( tc &&
+        tc->state.compare_exchange_strong(
+            expected,
+            detail::target_cache::busy,
+            std::memory_order_acquire,
+            std::memory_order_relaxed))
+    {
+        tc->p = t.data();
+        tc->n = t.size();
+        if(rv)
+        {
+            tc->ec = {};
+            tc->u = *rv;
+        }
+        else
+        {
+            tc->ec = rv.error();
+        }
+        tc->state.store(
+            detail::target_cache::ready,
+            std::memory_order_release);
+    }
+    return rv;
+}
+
+} // http_proto
+} // boost
@@ -14,8 +14,6 @@
 
 #include <utility>
 
-#include "detail/header_impl.hpp"
-
 namespace boost {
 namespace http_proto {
 
@@ -23,8 +21,16 @@ response::
 response() noexcept
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(
-        detail::kind::response)
+    , response_base()
+{
+}
+
+response::
+response(
+    container::pmr::memory_resource& mr) noexcept
+    : fields_view_base(
+        &this->fields_base::h_)
+    , response_base(mr)
 {
 }
 
@@ -33,8 +39,7 @@ response(
     core::string_view s)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(
-        detail::kind::response, s)
+    , response_base(s)
 {
 }
 
@@ -43,8 +48,7 @@ response(
     std::size_t storage_size)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(
-        detail::kind::response, storage_size)
+    , response_base(storage_size)
 {
 }
 
@@ -54,8 +58,7 @@ response(
     std::size_t max_storage_size)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(
-        detail::kind::response,
+    , response_base(
         storage_size, max_storage_size)
 {
 }
@@ -65,6 +68,9 @@ response(
     response&& other) noexcept
     : response()
 {
+    // the new object uses the same
+    // resource, as pmr containers do
+    h_.mr = other.h_.mr;
     swap(other);
 }
 
@@ -73,7 +79,7 @@ response(
     response const& other)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(*other.ph_)
+    , response_base(*other.ph_)
 {
 }
 
@@ -82,15 +88,22 @@ response(
     response_view const& other)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(*other.ph_)
+    , response_base(*other.ph_)
 {
 }
 
 response&
 response::
 operator=(
-    response&& other) noexcept
+    response&& other)
 {
+    // storage from another resource is
+    // copied, as pmr containers do
+    if(h_.mr != other.h_.mr)
+    {
+        copy_impl(*other.ph_);
+        return *this;
+    }
     response temp(
         std::move(other));
     temp.swap(*this);
@@ -116,47 +129,5 @@ response(
         set_start_line(sc, v);
 }
 
-//------------------------------------------------
-
-void
-response::
-set_impl(
-    http_proto::status sc,
-    unsigned short si,
-    core::string_view rs,
-    http_proto::version v)
-{
-    // measure and resize
-    auto const vs = to_string(v);
-    auto const n =
-        vs.size() + 1 +
-        3 + 1 +
-        rs.size() +
-        2;
-
-    detail::prefix_op op(*this, n);
-    auto dest = op.prefix_.data();
-
-    h_.version = v;
-    vs.copy(dest, vs.size());
-    dest += vs.size();
-    *dest++ = ' ';
-
-    h_.res.status = sc;
-    h_.res.status_int = si;
-    dest[0] = '0' + ((h_.res.status_int / 100) % 10);
-    dest[1] = '0' + ((h_.res.status_int /  10) % 10);
-    dest[2] = '0' + ((h_.res.status_int /   1) % 10);
-    dest[3] = ' ';
-    dest += 4;
-
-    rs.copy(dest, rs.size());
-    dest += rs.size();
-    dest[0] = '\r';
-    dest[1] = '\n';
-
-    h_.on_start_line();
-}
-
 } // http_proto
 } // boost
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/response_base.hpp>
+#include <boost/http_proto/version.hpp>
+
+#include "detail/header_impl.hpp"
+
+namespace boost {
+namespace http_proto {
+
+void
+response_base::
+set_impl(
+    http_proto::status sc,
+    unsigned short si,
+    core::string_view rs,
+    http_proto::version v)
+{
+    // measure and resize
+    auto const vs = to_string(v);
+    auto const n =
+        vs.size() + 1 +
+        3 + 1 +
+        rs.size() +
+        2;
+
+    detail::prefix_op op(*this, n);
+    auto dest = op.prefix_.data();
+
+    h_.version = v;
+    vs.copy(dest, vs.size());
+    dest += vs.size();
+    *dest++ = ' ';
+
+    h_.res.status = sc;
+    h_.res.status_int = si;
+    dest[0] = '0' + ((h_.res.status_int / 100) % 10);
+    dest[1] = '0' + ((h_.res.status_int /  10) % 10);
+    dest[2] = '0' + ((h_.res.status_int /   1) % 10);
+    dest[3] = ' ';
+    dest += 4;
+
+    rs.copy(dest, rs.size());
+    dest += rs.size();
+    dest[0] = '\r';
+    dest[1] = '\n';
+
+    h_.on_start_line();
+}
+
+} // http_proto
+} // boost
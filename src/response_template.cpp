@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/response_template.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+bool
+has_ctl(core::string_view s) noexcept
+{
+    for(unsigned char c : s)
+        if( (c < 0x20 && c != '\t') ||
+            c == 0x7f)
+            return true;
+    return false;
+}
+
+} // (anon)
+
+response_template::
+response_template(
+    response_view const& res,
+    std::initializer_list<slot> slots)
+{
+    if(slots.size() > max_slots)
+        detail::throw_length_error();
+
+    // a response with Transfer-Encoding
+    // must not have a Content-Length
+    bool const te =
+        res.metadata().transfer_encoding.count > 0;
+    slot list[max_slots];
+    std::size_t n = 0;
+    for(auto it = slots.begin();
+        it != slots.end(); ++it)
+    {
+        if(it->id == field::unknown)
+            detail::throw_invalid_argument();
+        // other fields in the metadata would
+        // go stale when their slot is set
+        if( it->id != field::content_length &&
+            res_.h_.is_special(it->id))
+            detail::throw_invalid_argument();
+        for(auto it2 = slots.begin();
+            it2 != it; ++it2)
+            if(it2->id == it->id)
+                detail::throw_invalid_argument();
+        if( it->id == field::content_length &&
+            te)
+            continue;
+        list[n++] = *it;
+    }
+
+    auto const is_slot =
+        [&](field id)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                if(list[i].id == id)
+                    return true;
+            return false;
+        };
+
+    auto const prefix =
+        res.buffer().find("\r\n") + 2;
+    std::string s(
+        res.buffer().data(), prefix);
+    std::size_t count = 0;
+    for(auto const& f : res)
+    {
+        if( f.id != field::unknown &&
+            is_slot(f.id))
+            continue;
+        s.append(f.name.data(), f.name.size());
+        s.append(": ");
+        s.append(f.value.data(), f.value.size());
+        s.append("\r\n");
+        ++count;
+    }
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const& sl = list[i];
+        core::string_view v;
+        auto const it = res.find(sl.id);
+        if(it != res.end())
+            v = it->value;
+        else if(sl.id == field::content_length)
+            v = "0";
+        if(v.size() > sl.width)
+            detail::throw_length_error();
+        s.append(to_string(sl.id));
+        s.append(": ");
+        auto& si = slots_[n_++];
+        si.id = sl.id;
+        si.width = sl.width;
+        si.index = count++;
+        si.pos = s.size();
+        s.append(v.data(), v.size());
+        s.append(sl.width - v.size(), ' ');
+        s.append("\r\n");
+    }
+    s.append("\r\n");
+    res_ = response(s);
+
+    // an empty value parses as starting
+    // after the padding, so point each
+    // entry at the start of its slot
+    auto& h = res_.h_;
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto const& si = slots_[i];
+        auto& e = detail::header::table(
+            h.buf + h.cap)[si.index];
+        e.vp = static_cast<
+            offset_type>(
+                si.pos - h.prefix);
+    }
+}
+
+void
+response_template::
+set(
+    field id,
+    core::string_view value)
+{
+    if(id == field::content_length)
+        detail::throw_invalid_argument();
+    auto const s = find(id);
+    if(! s)
+        detail::throw_invalid_argument();
+    if(value.size() > s->width)
+        detail::throw_length_error();
+    if(has_ctl(value))
+        detail::throw_invalid_argument();
+    write(*s, value);
+}
+
+void
+response_template::
+set_content_length(
+    std::uint64_t n)
+{
+    auto const s = find(field::content_length);
+    if(! s)
+        detail::throw_invalid_argument();
+    auto const n0 = n;
+    char buf[20];
+    auto const end = buf + sizeof(buf);
+    auto p = end;
+    do
+    {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    }
+    while(n > 0);
+    core::string_view const v(p, end - p);
+    if(v.size() > s->width)
+        detail::throw_length_error();
+    write(*s, v);
+
+    // the value may move the payload
+    // between none and a size
+    auto& h = res_.h_;
+    h.md.content_length.value = n0;
+    h.update_payload();
+}
+
+auto
+response_template::
+find(field id) noexcept ->
+    slot_info*
+{
+    for(std::size_t i = 0; i < n_; ++i)
+        if(slots_[i].id == id)
+            return &slots_[i];
+    return nullptr;
+}
+
+void
+response_template::
+write(
+    slot_info const& s,
+    core::string_view value) noexcept
+{
+    auto& h = res_.h_;
+    auto const p = h.buf + s.pos;
+    std::memcpy(p, value.data(), value.size());
+    std::memset(p + value.size(), ' ',
+        s.width - value.size());
+    detail::header::table(
+        h.buf + h.cap)[s.index].vn =
+            static_cast<offset_type>(
+                value.size());
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace detail {
+
+/*
+    OWS ";" OWS parameter
+*/
+struct media_param_rule_t
+{
+    using value_type = parameter;
+
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>
+    {
+        auto const it0 = it;
+        // OWS
+        it = grammar::find_if_not(
+            it, end, ws);
+        // ";"
+        if(it == end)
+        {
+            it = it0;
+            BOOST_HTTP_PROTO_RETURN_EC(
+                grammar::error::need_more);
+        }
+        if(*it != ';')
+        {
+            it = it0;
+            BOOST_HTTP_PROTO_RETURN_EC(
+                grammar::error::mismatch);
+        }
+        ++it;
+        // OWS
+        it = grammar::find_if_not(
+            it, end, ws);
+        // parameter
+        auto rv = grammar::parse(
+            it, end, parameter_rule);
+        if(! rv)
+            it = it0;
+        return rv;
+    }
+};
+
+constexpr media_param_rule_t media_param_rule{};
+
+} // detail
+
+//------------------------------------------------
+
+auto
+media_type_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type t;
+    // type
+    {
+        auto rv = grammar::parse(
+            it, end, token_rule);
+        if(! rv)
+            return rv.error();
+        t.mime.type = *rv;
+    }
+    // "/"
+    if(it == end)
+    {
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::need_more);
+    }
+    if(*it != '/')
+    {
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::mismatch);
+    }
+    ++it;
+    // subtype
+    {
+        auto rv = grammar::parse(
+            it, end, token_rule);
+        if(! rv)
+            return rv.error();
+        t.mime.subtype = *rv;
+    }
+    // *( OWS ";" OWS parameter )
+    {
+        auto rv = grammar::parse(it, end,
+            grammar::range_rule(
+                detail::media_param_rule));
+        if(! rv)
+            return rv.error();
+        t.params = std::move(*rv);
+    }
+    return t;
+}
+
+} // http_proto
+} // boost
@@ -8,6 +8,9 @@
 //
 
 #include <boost/http_proto/rfc/parameter.hpp>
+#include <boost/http_proto/rfc/quoted_token_rule.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/url/grammar/error.hpp>
 #include <boost/url/grammar/parse.hpp>
 
 namespace boost {
@@ -20,9 +23,42 @@ parse(
     char const* end) const noexcept ->
         system::result<value_type>
 {
-    (void)it;
-    (void)end;
-    return system::error_code{};
+    value_type t;
+    auto const it0 = it;
+    // token
+    {
+        auto rv = grammar::parse(
+            it, end, token_rule);
+        if(! rv)
+            return rv.error();
+        t.name = *rv;
+    }
+    // "="
+    if(it == end)
+    {
+        it = it0;
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::need_more);
+    }
+    if(*it != '=')
+    {
+        it = it0;
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::mismatch);
+    }
+    ++it;
+    // token / quoted-string
+    {
+        auto rv = grammar::parse(
+            it, end, quoted_token_rule);
+        if(! rv)
+        {
+            it = it0;
+            return rv.error();
+        }
+        t.value = *rv;
+    }
+    return t;
 }
 
 } // http_proto
@@ -9,8 +9,15 @@
 //
 
 #include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields_view.hpp>
+#include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/message_view_base.hpp>
+#include <boost/http_proto/mmap_body.hpp>
 #include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/service/brotli_service.hpp>
+#include <boost/http_proto/service/zlib_service.hpp>
+#include "detail/workspace_pool.hpp"
 #include <boost/buffers/algorithm.hpp>
 #include <boost/buffers/buffer_copy.hpp>
 #include <boost/buffers/buffer_size.hpp>
@@ -45,31 +52,48 @@ consume_buffers(
         detail::throw_invalid_argument();
 }
 
+// the size of the shortest chunk header
+// able to hold a chunk of `size` octets
+std::size_t
+chunk_header_len(
+    std::uint64_t size) noexcept
+{
+    std::size_t n = 1;
+    while(size >>= 4)
+        ++n;
+    return n + 2; // CRLF
+}
+
+// Writes the chunk size in hex, padded with
+// zeros to fill `dest0`, followed by CRLF
 template<class MutableBuffers>
 void
 write_chunk_header(
     MutableBuffers const& dest0,
-    std::size_t size) noexcept
+    std::uint64_t size) noexcept
 {
     static constexpr char hexdig[] =
         "0123456789ABCDEF";
+    auto const len =
+        buffers::buffer_size(dest0);
+    BOOST_ASSERT(
+        len >= chunk_header_len(size) &&
+        len <= 18);
     char buf[18];
-    auto p = buf + 16;
-    for(std::size_t i = 16; i--;)
+    auto p = buf + len - 2;
+    while(p != buf)
     {
         *--p = hexdig[size & 0xf];
         size >>= 4;
     }
-    buf[16] = '\r';
-    buf[17] = '\n';
+    buf[len - 2] = '\r';
+    buf[len - 1] = '\n';
     auto n = buffers::buffer_copy(
         dest0,
         buffers::const_buffer(
-            buf, sizeof(buf)));
+            buf, len));
     ignore_unused(n);
-    BOOST_ASSERT(n == 18);
-    BOOST_ASSERT(
-        buffers::buffer_size(dest0) == n);
+    BOOST_ASSERT(n == len);
 }
 
 template<class DynamicBuffer>
@@ -82,14 +106,69 @@ write_chunk_close(DynamicBuffer& db)
             buffers::const_buffer("\r\n", 2)));
 }
 
+// When trailers follow, the final
+// CRLF ends the trailer section
 template<class DynamicBuffer>
 void
-write_last_chunk(DynamicBuffer& db)
+write_last_chunk(
+    DynamicBuffer& db,
+    bool trailers = false)
 {
+    std::size_t const n =
+        trailers ? 3 : 5;
     db.commit(
         buffers::buffer_copy(
-            db.prepare(5),
-            buffers::const_buffer("0\r\n\r\n", 5)));
+            db.prepare(n),
+            buffers::const_buffer("0\r\n\r\n", n)));
+}
+
+// Fields which may not appear in a
+// trailer section, rfc9110 6.5.1
+static
+bool
+is_forbidden_trailer(
+    field id) noexcept
+{
+    switch(id)
+    {
+    case field::authorization:
+    case field::cache_control:
+    case field::content_encoding:
+    case field::content_length:
+    case field::content_range:
+    case field::content_type:
+    case field::expect:
+    case field::host:
+    case field::max_forwards:
+    case field::pragma:
+    case field::range:
+    case field::set_cookie:
+    case field::te:
+    case field::trailer:
+    case field::transfer_encoding:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// extra workspace needed by the encoders,
+// only one of which is used per message
+static
+std::size_t
+codec_space_needed(
+    context& ctx) noexcept
+{
+    std::size_t n = 0;
+    auto const svc0 = ctx.find_service<
+        zlib::deflate_encoder_service>();
+    if( svc0 && n < svc0->space_needed())
+        n = svc0->space_needed();
+    auto const svc1 = ctx.find_service<
+        brotli::encoder_service>();
+    if( svc1 && n < svc1->space_needed())
+        n = svc1->space_needed();
+    return n;
 }
 
 //------------------------------------------------
@@ -116,10 +195,37 @@ serializer(
 {
 }
 
+serializer::
+serializer(
+    context& ctx)
+    : serializer(ctx, 65536)
+{
+}
+
+serializer::
+serializer(
+    context& ctx,
+    std::size_t buffer_size)
+    : deflate_svc_(ctx.find_service<
+        zlib::deflate_encoder_service>())
+    , brotli_svc_(ctx.find_service<
+        brotli::encoder_service>())
+{
+    auto const n = buffer_size +
+        codec_space_needed(ctx);
+    auto const pool = ctx.find_service<
+        detail::workspace_pool>();
+    if(pool)
+        ws_.allocate(n, *pool);
+    else
+        ws_.allocate(n);
+}
+
 void
 serializer::
 reset() noexcept
 {
+    ws_.release();
 }
 
 //------------------------------------------------
@@ -160,7 +266,14 @@ prepare() ->
 
     if(st_ == style::source)
     {
-        if(more_)
+        if(filt_)
+        {
+            system::error_code ec;
+            encode(ec);
+            if(ec.failed())
+                return ec;
+        }
+        else if(more_)
         {
             if(! is_chunked_)
             {
@@ -180,8 +293,12 @@ prepare() ->
                         2 - // CRLF
                         5); // final chunk
 
+                    // wide enough for any
+                    // chunk that fits
+                    auto const hn = chunk_header_len(
+                        buffers::buffer_size(dest));
                     auto rv = src_->read(
-                        buffers::sans_prefix(dest, 18));
+                        buffers::sans_prefix(dest, hn));
 
                     if(rv.ec.failed())
                         return rv.ec;
@@ -189,8 +306,8 @@ prepare() ->
                     if(rv.bytes != 0)
                     {
                         write_chunk_header(
-                            buffers::prefix(dest, 18), rv.bytes);
-                        tmp0_.commit(rv.bytes + 18);
+                            buffers::prefix(dest, hn), rv.bytes);
+                        tmp0_.commit(rv.bytes + hn);
                         // terminate chunk
                         tmp0_.commit(
                             buffers::buffer_copy(
@@ -225,6 +342,17 @@ prepare() ->
 
     if(st_ == style::stream)
     {
+        if(filt_)
+        {
+            system::error_code ec;
+            encode(ec);
+            if(ec.failed())
+                return ec;
+        }
+        else if(writes_tmp1())
+        {
+            frame_chunks();
+        }
         std::size_t n = 0;
         if(out_.data() == hp_)
             ++n;
@@ -233,14 +361,74 @@ prepare() ->
             BOOST_HTTP_PROTO_RETURN_EC(
                 error::need_data);
         }
+        if( ! is_chunked_ &&
+            more_ &&
+            ! flush_ &&
+            tmp0_.size() < coalesce_ &&
+            tmp0_.capacity() > 0)
+        {
+            // gather more before sending
+            BOOST_HTTP_PROTO_RETURN_EC(
+                error::need_data);
+        }
         for(buffers::const_buffer const& b : tmp0_.data())
             out_[n++] = b;
 
+        // the trailers follow the last-chunk
+        if( ! more_ && (
+                filter_done_ || ! writes_tmp1()))
+            out_[n] = tb_;
+        else
+            out_[n] = {};
+
         return const_buffers_type(
             out_.data(),
             out_.size());
     }
 
+    if(st_ == style::file)
+    {
+        auto n = out_.size();
+        if(fr_.size > 0)
+        {
+            n -= tail_;
+            if(n == 0)
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    error::need_file);
+        }
+        return const_buffers_type(
+            out_.data(), n);
+    }
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    if(st_ == style::mapped)
+    {
+        // map more of the body once
+        // the previous part is sent
+        if( mb_->size() > 0 &&
+            (out_.data() > mp_ ||
+                mp_->size() == 0))
+        {
+            system::error_code ec;
+            *mp_ = mb_->data(ec);
+            if(ec.failed())
+                return ec;
+            if(out_.data() > mp_)
+                out_ = { mp_, out_.size() + 1 };
+        }
+
+        // the final chunk follows
+        // the last of the body
+        tail_ = 0;
+        if( is_chunked_ &&
+            mp_->size() < mb_->size())
+            tail_ = 1;
+        return const_buffers_type(
+            out_.data(),
+            out_.size() - tail_);
+    }
+#endif
+
     // should never get here
     detail::throw_logic_error();
 }
@@ -282,27 +470,84 @@ consume(
     case style::empty:
         out_.consume(n);
         if(out_.empty())
-            is_done_ = true;
+            set_done();
         return;
 
     case style::buffers:
         out_.consume(n);
         if(out_.empty())
-            is_done_ = true;
+            set_done();
+        return;
+
+    case style::file:
+        // Cannot consume past the file
+        if( fr_.size > 0 &&
+            n > buffers::buffer_size(
+                const_buffers_type(
+                    out_.data(),
+                    out_.size() - tail_)))
+            detail::throw_invalid_argument();
+        out_.consume(n);
+        if( out_.empty() &&
+            fr_.size == 0)
+            set_done();
+        return;
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    case style::mapped:
+    {
+        // Cannot consume past the output
+        if(n > buffers::buffer_size(
+                const_buffers_type(
+                    out_.data(),
+                    out_.size() - tail_)))
+            detail::throw_invalid_argument();
+        auto const n0 = out_.data() <= mp_ ?
+            mp_->size() : 0;
+        out_.consume(n);
+        auto const n1 = out_.data() <= mp_ ?
+            mp_->size() : 0;
+        mb_->consume(n0 - n1);
+        if( out_.empty() &&
+            mb_->size() == 0)
+            set_done();
         return;
+    }
+#endif
 
     case style::source:
     case style::stream:
+        if(n > tmp0_.size())
+        {
+            // into the trailers
+            tb_ += n - tmp0_.size();
+            n = tmp0_.size();
+        }
         tmp0_.consume(n);
-        if( tmp0_.size() == 0 &&
-                ! more_)
-            is_done_ = true;
+        if( tmp0_.size() != 0 ||
+            tb_.size() != 0)
+            return;
+        if(! is_chunked_)
+            flush_ = false;
+        if( ! more_ && (
+                filter_done_ || ! writes_tmp1()))
+            set_done();
         return;
     }
 }
 
 //------------------------------------------------
 
+// storage borrowed from a pool is returned
+// as soon as the message is complete
+void
+serializer::
+set_done() noexcept
+{
+    is_done_ = true;
+    ws_.release();
+}
+
 void
 serializer::
 copy(
@@ -320,6 +565,7 @@ start_init(
     message_view_base const& m)
 {
     ws_.clear();
+    ws_.acquire();
 
     // VFALCO what do we do with
     // metadata error code failures?
@@ -330,6 +576,12 @@ start_init(
     is_expect_continue_ =
         m.ph_->md.expect.is_100_continue;
 
+    filt_ = nullptr;
+    filter_done_ = false;
+    coalesce_ = 0;
+    flush_ = false;
+    tb_ = {};
+
     // Transfer-Encoding
     {
         auto const& te =
@@ -413,15 +665,16 @@ start_buffers(
             copy(&out_[2],
                 buf_.data(), buf_.size());
 
+            auto const size =
+                buffers::buffer_size(buf_);
+            auto const hn = chunk_header_len(size);
+
             // Buffer is too small
-            if(ws_.size() < 18 + 7)
+            if(ws_.size() < hn + 7)
                 detail::throw_length_error();
-            buffers::mutable_buffer s1(ws_.data(), 18);
-            buffers::mutable_buffer s2(ws_.data(), 18 + 7);
-            s2 += 18; // VFALCO HACK
-            write_chunk_header(
-                s1,
-                buffers::buffer_size(buf_));
+            buffers::mutable_buffer s1(ws_.data(), hn);
+            buffers::mutable_buffer s2(ws_.data() + hn, 7);
+            write_chunk_header(s1, size);
             buffers::buffer_copy(s2, buffers::const_buffer(
                 "\r\n"
                 "0\r\n"
@@ -454,7 +707,8 @@ start_source(
     out_ = make_array(
         1 + // header
         2); // tmp
-    //if(! cod_)
+    init_filter(m);
+    if(! filt_)
     {
         tmp0_ = { ws_.data(), ws_.size() };
         if(tmp0_.capacity() <
@@ -464,45 +718,144 @@ start_source(
                 5)      // final chunk
             detail::throw_length_error();
     }
-#if 0
     else
     {
-        buffers::buffered_base::allocator a(
-            ws_.data(), ws_.size()/3, false);
-        src->init(a);
-        ws_.reserve(a.size_used());
-
+        // tmp1_ holds the body and tmp0_
+        // holds the encoded output
         auto const n = ws_.size() / 2;
+        tmp0_ = { ws_.data(), n };
+        tmp1_ = { ws_.data() + n, ws_.size() - n };
 
-        tmp0_ = { ws_.data(), ws_.size() / 2 };
-        ws_.reserve(n);
+        // Buffer is too small
+        if( tmp0_.capacity() <
+                chunked_overhead_ + 1 ||
+            tmp1_.capacity() < 1)
+            detail::throw_length_error();
+    }
+
+    hp_ = &out_[0];
+    *hp_ = { m.ph_->cbuf, m.ph_->size };
+    more_ = true;
+}
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+void
+serializer::
+start_source(
+    message_view_base const& m,
+    mmap_body* mb)
+{
+    // encoded output must be
+    // copied through the workspace
+    if(body_encoding(m) != encoding::identity)
+        return start_source(m,
+            static_cast<source*>(mb));
+
+    st_ = style::mapped;
+    mb_ = mb;
+    tail_ = 0;
+    if(! is_chunked_)
+    {
+        out_ = make_array(
+            1 + // header
+            1); // body
+        mp_ = &out_[1];
+    }
+    else if(mb->size() == 0)
+    {
+        out_ = make_array(
+            1 + // header
+            1 + // body
+            1); // final chunk
 
         // Buffer is too small
-        if(ws_.size() < 1)
+        if(ws_.size() < 5)
             detail::throw_length_error();
 
-        tmp1_ = { ws_.data(), ws_.size() };
+        buffers::mutable_buffer dest(
+            ws_.data(), 5);
+        buffers::buffer_copy(
+            dest,
+            buffers::const_buffer(
+                "0\r\n\r\n", 5));
+        mp_ = &out_[1];
+        out_[2] = dest;
+    }
+    else
+    {
+        // the whole body is one chunk
+        out_ = make_array(
+            1 + // header
+            1 + // chunk size
+            1 + // body
+            1); // final chunk
+
+        auto const hn = chunk_header_len(mb->size());
+
+        // Buffer is too small
+        if(ws_.size() < hn + 7)
+            detail::throw_length_error();
+        buffers::mutable_buffer s1(ws_.data(), hn);
+        buffers::mutable_buffer s2(ws_.data() + hn, 7);
+        write_chunk_header(s1, mb->size());
+        buffers::buffer_copy(s2, buffers::const_buffer(
+            "\r\n"
+            "0\r\n"
+            "\r\n", 7));
+        out_[1] = s1;
+        mp_ = &out_[2];
+        out_[3] = s2;
     }
-#endif
 
     hp_ = &out_[0];
     *hp_ = { m.ph_->cbuf, m.ph_->size };
-    more_ = true;
 }
+#endif
 
 auto
 serializer::
 start_stream(
     message_view_base const& m) ->
         stream
+{
+    return start_stream(m, 0);
+}
+
+auto
+serializer::
+start_stream(
+    message_view_base const& m,
+    std::size_t threshold) ->
+        stream
 {
     start_init(m);
 
     st_ = style::stream;
     out_ = make_array(
         1 + // header
-        2); // tmp
-    //if(! cod_)
+        2 + // tmp
+        1); // trailers
+    init_filter(m);
+    stream_header_len_ = chunk_header_len_;
+    if(! filt_)
+        coalesce_ = threshold;
+    if(! filt_ && writes_tmp1())
+    {
+        // the stream gathers data in tmp1_,
+        // and tmp0_ holds the framed chunks
+        auto n = ws_.size() / 2;
+        if( n > coalesce_)
+            n = coalesce_;
+        tmp1_ = { ws_.data(), n };
+        tmp0_ = { ws_.data() + n, ws_.size() - n };
+
+        // Buffer is too small
+        if( tmp0_.capacity() <
+                chunked_overhead_ + 1 ||
+            tmp1_.capacity() < 1)
+            detail::throw_length_error();
+    }
+    else if(! filt_)
     {
         tmp0_ = { ws_.data(), ws_.size() };
         if(tmp0_.capacity() <
@@ -512,20 +865,20 @@ start_stream(
                 5)      // final chunk
             detail::throw_length_error();
     }
-#if 0
     else
     {
+        // the stream writes to tmp1_, and
+        // tmp0_ holds the encoded output
         auto const n = ws_.size() / 2;
         tmp0_ = { ws_.data(), n };
-        ws_.reserve(n);
+        tmp1_ = { ws_.data() + n, ws_.size() - n };
 
         // Buffer is too small
-        if(ws_.size() < 1)
+        if( tmp0_.capacity() <
+                chunked_overhead_ + 1 ||
+            tmp1_.capacity() < 1)
             detail::throw_length_error();
-
-        tmp1_ = { ws_.data(), ws_.size() };
     }
-#endif
 
     hp_ = &out_[0];
     *hp_ = { m.ph_->cbuf, m.ph_->size };
@@ -535,6 +888,311 @@ start_stream(
     return stream{*this};
 }
 
+void
+serializer::
+start_file(
+    message_view_base const& m,
+    file_body&& body)
+{
+    start_init(m);
+
+    st_ = style::file;
+    auto& fb = ws_.emplace<
+        file_body>(std::move(body));
+    system::error_code ec;
+    fr_ = fb.data(ec);
+    if(ec.failed())
+        detail::throw_system_error(ec);
+
+    if(! is_chunked_)
+    {
+        out_ = make_array(
+            1); // header
+        tail_ = 0;
+    }
+    else if(fr_.size == 0)
+    {
+        out_ = make_array(
+            1 + // header
+            1); // final chunk
+        tail_ = 1;
+
+        // Buffer is too small
+        if(ws_.size() < 5)
+            detail::throw_length_error();
+
+        buffers::mutable_buffer dest(
+            ws_.data(), 5);
+        buffers::buffer_copy(
+            dest,
+            buffers::const_buffer(
+                "0\r\n\r\n", 5));
+        out_[1] = dest;
+    }
+    else
+    {
+        // the whole file is one chunk
+        out_ = make_array(
+            1 + // header
+            1 + // chunk size
+            1); // final chunk
+        tail_ = 1;
+
+        auto const hn = chunk_header_len(fr_.size);
+
+        // Buffer is too small
+        if(ws_.size() < hn + 7)
+            detail::throw_length_error();
+        buffers::mutable_buffer s1(ws_.data(), hn);
+        buffers::mutable_buffer s2(ws_.data() + hn, 7);
+        write_chunk_header(s1, fr_.size);
+        buffers::buffer_copy(s2, buffers::const_buffer(
+            "\r\n"
+            "0\r\n"
+            "\r\n", 7));
+        out_[1] = s1;
+        out_[2] = s2;
+    }
+
+    hp_ = &out_[0];
+    *hp_ = { m.ph_->cbuf, m.ph_->size };
+}
+
+void
+serializer::
+consume_file(
+    std::uint64_t n)
+{
+    // Precondition violation
+    if( is_done_ ||
+        st_ != style::file)
+        detail::throw_logic_error();
+
+    // Cannot consume more than the file
+    // or before the output ahead of it
+    if( n > fr_.size ||
+        out_.size() != tail_)
+        detail::throw_invalid_argument();
+
+    fr_.offset += n;
+    fr_.size -= n;
+    if( fr_.size == 0 &&
+        out_.empty())
+        set_done();
+}
+
+// Returns the coding which the serializer
+// applies to the body, if a service is
+// installed for it
+encoding
+serializer::
+body_encoding(
+    message_view_base const& m) const noexcept
+{
+    // a transfer-coding is applied
+    // after any content-coding
+    auto const& md = m.ph_->md;
+    auto e = md.transfer_encoding.encoding;
+    if(e == encoding::identity)
+        e = md.content_encoding.encoding;
+    switch(e)
+    {
+    case encoding::deflate:
+    case encoding::gzip:
+        if(deflate_svc_)
+            return e;
+        break;
+
+    case encoding::br:
+        if(brotli_svc_)
+            return e;
+        break;
+
+    default:
+        break;
+    }
+    return encoding::identity;
+}
+
+void
+serializer::
+init_filter(
+    message_view_base const& m)
+{
+    switch(body_encoding(m))
+    {
+    case encoding::deflate:
+        filt_ = &deflate_svc_->make_filter(
+            ws_, false);
+        break;
+
+    case encoding::gzip:
+        filt_ = &deflate_svc_->make_filter(
+            ws_, true);
+        break;
+
+    case encoding::br:
+        filt_ = &brotli_svc_->make_filter(ws_);
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Move the body from tmp1_ through the
+// filter into tmp0_, framing each block
+// of output as a chunk when chunked.
+void
+serializer::
+encode(
+    system::error_code& ec)
+{
+    for(;;)
+    {
+        if( st_ == style::source &&
+            more_ &&
+            tmp1_.capacity() > 0)
+        {
+            auto rv = src_->read(
+                tmp1_.prepare(
+                    tmp1_.capacity()));
+            tmp1_.commit(rv.bytes);
+            if(rv.ec.failed())
+            {
+                ec = rv.ec;
+                return;
+            }
+            more_ = ! rv.finished;
+        }
+
+        if(filter_done_)
+            return;
+
+        if(! is_chunked_)
+        {
+            if(tmp0_.capacity() == 0)
+                return;
+        }
+        else if(tmp0_.capacity() <=
+            chunked_overhead_)
+        {
+            // no room for a chunk
+            // and the last-chunk
+            return;
+        }
+
+        filter::results rs;
+        auto const dest = tmp0_.prepare(
+            tmp0_.capacity());
+        if(! is_chunked_)
+        {
+            rs = filt_->process(
+                dest, tmp1_.data(), more_);
+            tmp0_.commit(rs.out_bytes);
+        }
+        else
+        {
+            auto const room =
+                buffers::buffer_size(dest) -
+                crlf_len_ -
+                last_chunk_len_;
+            auto const hn =
+                chunk_header_len(room);
+            rs = filt_->process(
+                buffers::sans_prefix(
+                    buffers::prefix(dest, room),
+                    hn),
+                tmp1_.data(),
+                more_);
+            if(rs.out_bytes != 0)
+            {
+                write_chunk_header(
+                    buffers::prefix(dest, hn),
+                    rs.out_bytes);
+                tmp0_.commit(
+                    hn + rs.out_bytes);
+                write_chunk_close(tmp0_);
+            }
+        }
+        tmp1_.consume(rs.in_bytes);
+        if(rs.ec.failed())
+        {
+            ec = rs.ec;
+            return;
+        }
+        if(rs.finished)
+        {
+            filter_done_ = true;
+            if(is_chunked_)
+                write_last_chunk(
+                    tmp0_, tb_.size() != 0);
+            return;
+        }
+        if( rs.in_bytes == 0 &&
+            rs.out_bytes == 0)
+        {
+            // needs more input
+            // or output space
+            return;
+        }
+    }
+}
+
+// Frame the data gathered by the stream as
+// chunks, once enough is pending or when
+// flushed or closed. Each chunk header is
+// only as wide as its size requires.
+void
+serializer::
+frame_chunks()
+{
+    for(;;)
+    {
+        auto const n = tmp1_.size();
+        if(n == 0)
+            break;
+        if( n < coalesce_ &&
+            tmp1_.capacity() > 0 &&
+            more_ &&
+            ! flush_)
+            return;
+
+        if(tmp0_.capacity() <=
+            chunked_overhead_)
+        {
+            // no room for a chunk
+            // and the last-chunk
+            return;
+        }
+        auto const room =
+            tmp0_.capacity() -
+            crlf_len_ -
+            last_chunk_len_;
+        auto m = room - chunk_header_len(room);
+        if( m > n)
+            m = n;
+        auto const hn = chunk_header_len(m);
+        write_chunk_header(
+            tmp0_.prepare(hn), m);
+        tmp0_.commit(hn);
+        tmp0_.commit(buffers::buffer_copy(
+            tmp0_.prepare(m),
+            tmp1_.data()));
+        tmp1_.consume(m);
+        write_chunk_close(tmp0_);
+    }
+    flush_ = false;
+    if( ! more_ &&
+        ! filter_done_)
+    {
+        // all gathered data is framed
+        write_last_chunk(
+            tmp0_, tb_.size() != 0);
+        filter_done_ = true;
+    }
+}
+
 //------------------------------------------------
 
 std::size_t
@@ -542,6 +1200,8 @@ serializer::
 stream::
 capacity() const noexcept
 {
+    if(sr_->writes_tmp1())
+        return sr_->tmp1_.capacity();
     return sr_->tmp0_.capacity();
 }
 
@@ -550,6 +1210,8 @@ serializer::
 stream::
 size() const noexcept
 {
+    if(sr_->writes_tmp1())
+        return sr_->tmp1_.size();
     return sr_->tmp0_.size();
 }
 
@@ -558,6 +1220,9 @@ serializer::
 stream::
 is_full() const noexcept
 {
+    if(sr_->writes_tmp1())
+        return capacity() == 0;
+
     if( sr_->is_chunked_ )
         return capacity() < chunked_overhead_ + 1;
 
@@ -570,6 +1235,12 @@ stream::
 prepare() const ->
     buffers_type
 {
+    // the encoder, or the gathering,
+    // applies any chunked framing later
+    if(sr_->writes_tmp1())
+        return sr_->tmp1_.prepare(
+            sr_->tmp1_.capacity());
+
     auto n = sr_->tmp0_.capacity();
     if( sr_->is_chunked_ )
     {
@@ -586,9 +1257,13 @@ prepare() const ->
             detail::throw_length_error();
 
         n -= chunked_overhead_;
+
+        // the header is only as wide
+        // as the largest chunk needs
+        auto const hn = chunk_header_len(n);
+        sr_->stream_header_len_ = hn;
         return buffers::sans_prefix(
-            sr_->tmp0_.prepare(chunk_header_len_ + n),
-            chunk_header_len_);
+            sr_->tmp0_.prepare(hn + n), hn);
     }
 
     return sr_->tmp0_.prepare(n);
@@ -599,7 +1274,11 @@ serializer::
 stream::
 commit(std::size_t n) const
 {
-    if(! sr_->is_chunked_ )
+    if(sr_->writes_tmp1())
+    {
+        sr_->tmp1_.commit(n);
+    }
+    else if(! sr_->is_chunked_ )
     {
         sr_->tmp0_.commit(n);
     }
@@ -610,15 +1289,24 @@ commit(std::size_t n) const
         if( n == 0 )
             detail::throw_logic_error();
 
-        auto m = n + chunk_header_len_;
+        auto const hn = sr_->stream_header_len_;
+        auto m = n + hn;
         auto dest = sr_->tmp0_.prepare(m);
         write_chunk_header(
-            buffers::prefix(dest, chunk_header_len_), n);
+            buffers::prefix(dest, hn), n);
         sr_->tmp0_.commit(m);
         write_chunk_close(sr_->tmp0_);
     }
 }
 
+void
+serializer::
+stream::
+flush() const
+{
+    sr_->flush_ = true;
+}
+
 void
 serializer::
 stream::
@@ -628,12 +1316,41 @@ close() const
     if(! sr_->more_ )
         detail::throw_logic_error();
 
-    if( sr_->is_chunked_ )
-        write_last_chunk(sr_->tmp0_);
+    // the encoder, or the gathering, writes
+    // the last-chunk after its output
+    if( sr_->is_chunked_ &&
+        ! sr_->writes_tmp1())
+        write_last_chunk(
+            sr_->tmp0_,
+            sr_->tb_.size() != 0);
 
     sr_->more_ = false;
 }
 
+void
+serializer::
+stream::
+close(
+    fields_view const& trailers) const
+{
+    // Precondition violation
+    if(! sr_->more_ )
+        detail::throw_logic_error();
+
+    if(trailers.size() != 0)
+    {
+        // trailers need the chunked coding
+        if(! sr_->is_chunked_ )
+            detail::throw_logic_error();
+        for(auto const& f : trailers)
+            if(is_forbidden_trailer(f.id))
+                detail::throw_invalid_argument();
+        auto const s = trailers.buffer();
+        sr_->tb_ = { s.data(), s.size() };
+    }
+    close();
+}
+
 //------------------------------------------------
 
 } // http_proto
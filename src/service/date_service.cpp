@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/date_service.hpp>
+#include <chrono>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+void
+put2(char* p, unsigned v) noexcept
+{
+    p[0] = static_cast<char>('0' + v / 10);
+    p[1] = static_cast<char>('0' + v % 10);
+}
+
+} // (anon)
+
+date_service::
+date_service(context&) noexcept
+    : seq_(0)
+    , t_(-1)
+{
+    for(auto& w : w_)
+        w.store(0, std::memory_order_relaxed);
+}
+
+auto
+date_service::
+now() const noexcept ->
+    value_type
+{
+    using namespace std::chrono;
+    auto const t = duration_cast<seconds>(
+        system_clock::now().time_since_epoch()
+            ).count();
+
+    value_type v;
+    std::uint64_t w[words];
+    auto s0 = seq_.load(
+        std::memory_order_acquire);
+    if( (s0 & 1) == 0 &&
+        t_.load(std::memory_order_relaxed) == t)
+    {
+        for(std::size_t i = 0; i < words; ++i)
+            w[i] = w_[i].load(
+                std::memory_order_relaxed);
+        std::atomic_thread_fence(
+            std::memory_order_acquire);
+        if(seq_.load(
+            std::memory_order_relaxed) == s0)
+        {
+            std::memcpy(v.buf_, w, date_size);
+            return v;
+        }
+    }
+
+    // stale or contended: format here,
+    // and publish unless another
+    // thread is already doing so
+    v = format(t);
+    if( (s0 & 1) == 0 &&
+        seq_.compare_exchange_strong(
+            s0, s0 + 1,
+            std::memory_order_relaxed))
+    {
+        std::atomic_thread_fence(
+            std::memory_order_release);
+        std::memset(w, 0, sizeof(w));
+        std::memcpy(w, v.buf_, date_size);
+        for(std::size_t i = 0; i < words; ++i)
+            w_[i].store(w[i],
+                std::memory_order_relaxed);
+        t_.store(t, std::memory_order_relaxed);
+        seq_.store(s0 + 2,
+            std::memory_order_release);
+    }
+    return v;
+}
+
+auto
+date_service::
+format(std::int64_t t) noexcept ->
+    value_type
+{
+    static constexpr char const* wkday[] = {
+        "Sun", "Mon", "Tue", "Wed",
+        "Thu", "Fri", "Sat" };
+    static constexpr char const* month[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+    auto days = t / 86400;
+    auto secs = t % 86400;
+    if(secs < 0)
+    {
+        secs += 86400;
+        --days;
+    }
+
+    // civil date from days since
+    // 1970-01-01, which was a Thursday
+    auto const wd = static_cast<unsigned>(
+        (days % 7 + 11) % 7);
+    auto const z = days + 719468;
+    auto const era =
+        (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = z - era * 146097;
+    auto const yoe = (doe - doe / 1460 +
+        doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe -
+        (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const d = static_cast<unsigned>(
+        doy - (153 * mp + 2) / 5 + 1);
+    auto const m = static_cast<unsigned>(
+        mp < 10 ? mp + 3 : mp - 9);
+    auto const y = static_cast<unsigned>(
+        (yoe + era * 400 + (m <= 2)) % 10000);
+
+    // "Sun, 06 Nov 1994 08:49:37 GMT"
+    value_type v;
+    auto const p = v.buf_;
+    std::memcpy(p, wkday[wd], 3);
+    p[3] = ',';
+    p[4] = ' ';
+    put2(p + 5, d);
+    p[7] = ' ';
+    std::memcpy(p + 8, month[m - 1], 3);
+    p[11] = ' ';
+    put2(p + 12, y / 100);
+    put2(p + 14, y % 100);
+    p[16] = ' ';
+    put2(p + 17, static_cast<unsigned>(secs / 3600));
+    p[19] = ':';
+    put2(p + 20, static_cast<unsigned>(secs / 60 % 60));
+    p[22] = ':';
+    put2(p + 23, static_cast<unsigned>(secs % 60));
+    std::memcpy(p + 25, " GMT", 4);
+    return v;
+}
+
+date_service&
+install_date_service(
+    context& ctx)
+{
+    return ctx.make_service<
+        date_service>();
+}
+
+} // http_proto
+} // boost
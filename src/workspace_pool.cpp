@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/workspace_pool.hpp>
+#include <boost/http_proto/context.hpp>
+#include "detail/workspace_pool.hpp"
+#include <cstring>
+#include <stddef.h> // ::max_align_t
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+// the size of each block is stored
+// in front of it, keeping alignment
+static constexpr std::size_t prefix =
+    alignof(::max_align_t);
+
+static_assert(
+    prefix >= sizeof(std::size_t),
+    "prefix too small");
+
+static
+std::size_t
+block_size(
+    unsigned char const* p) noexcept
+{
+    std::size_t n;
+    std::memcpy(&n, p, sizeof(n));
+    return n;
+}
+
+workspace_pool::
+workspace_pool(
+    context&,
+    std::size_t max_idle)
+    : slots_(new std::atomic<
+        unsigned char*>[max_idle])
+    , n_(max_idle)
+{
+    for(std::size_t i = 0; i < n_; ++i)
+        slots_[i].store(nullptr,
+            std::memory_order_relaxed);
+}
+
+workspace_pool::
+~workspace_pool()
+{
+    for(std::size_t i = 0; i < n_; ++i)
+        delete[] slots_[i].load(
+            std::memory_order_relaxed);
+}
+
+unsigned char*
+workspace_pool::
+acquire(std::size_t n)
+{
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto& slot = slots_[i];
+        if(! slot.load(
+                std::memory_order_relaxed))
+            continue;
+        auto const p = slot.exchange(
+            nullptr, std::memory_order_acquire);
+        if(! p)
+            continue;
+        if(block_size(p) == n)
+            return p + prefix;
+
+        // wrong size, put it back
+        unsigned char* empty = nullptr;
+        if(! slot.compare_exchange_strong(
+                empty, p,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+            delete[] p;
+    }
+
+    auto const p =
+        new unsigned char[prefix + n];
+    std::memcpy(p, &n, sizeof(n));
+    return p + prefix;
+}
+
+void
+workspace_pool::
+release(
+    unsigned char* p) noexcept
+{
+    p -= prefix;
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto& slot = slots_[i];
+        if(slot.load(
+                std::memory_order_relaxed))
+            continue;
+        unsigned char* empty = nullptr;
+        if(slot.compare_exchange_strong(
+                empty, p,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+            return;
+    }
+    // pool is full
+    delete[] p;
+}
+
+} // detail
+
+void
+install_workspace_pool(
+    context& ctx,
+    std::size_t max_idle)
+{
+    ctx.make_service<
+        detail::workspace_pool>(max_idle);
+}
+
+} // http_proto
+} // boost
@@ -11,7 +11,10 @@
 #define BOOST_HTTP_PROTO_SERVICE_IMPL_ZLIB_SERVICE_IPP
 
 #include <boost/http_proto/service/zlib_service.hpp>
+#include <boost/http_proto/detail/except.hpp>
 #include <boost/system/result.hpp>
+#include <cstddef>
+#include <limits>
 #include "zlib.h"
 
 namespace boost {
@@ -181,7 +184,9 @@ public:
         ec = static_cast<error>(
             deflate(&zs_,
                 Z_FULL_FLUSH));
-        if(ec.failed())
+        // no output space is expected
+        if( ec.failed() &&
+            ec != error::buf_err)
             return ec;
         ec = static_cast<error>(
             deflateEnd(&zs_));
@@ -190,6 +195,24 @@ public:
         return n_;
     }
 
+    system::result<std::size_t>
+    inflate_init2(
+        int windowBits)
+    {
+        n_ = 0;
+        system::error_code ec;
+        ec = static_cast<error>(
+            inflateInit2(&zs_,
+                windowBits));
+        if(ec.failed())
+            return ec;
+        ec = static_cast<error>(
+            inflateEnd(&zs_));
+        if(ec.failed())
+            return ec;
+        return n_;
+    }
+
 private:
     static void* zalloc(void* opaque,
         uInt num, uInt size)
@@ -214,6 +237,200 @@ private:
 
 //------------------------------------------------
 
+/*  Base for filters which use zlib.
+
+    All of the memory used by zlib, including
+    the sliding window, is carved out of a
+    single block acquired from the workspace
+    at construction. Nothing is freed until
+    the workspace is cleared, so inflateEnd
+    and deflateEnd are not needed.
+*/
+class zlib_filter
+    : public filter
+{
+public:
+    // overhead of each allocation
+    // carved out of the block
+    static constexpr std::size_t slack =
+        alignof(::max_align_t);
+
+protected:
+    zlib_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size)
+        : p_(ws.push_array(
+            block_size,
+            static_cast<unsigned char>(0)))
+        , n_(block_size)
+    {
+        zs_.zalloc = &zalloc;
+        zs_.zfree = &zfree;
+        zs_.opaque = this;
+    }
+
+    // calls fn once with the buffers
+    // prepared in zs_, and fills in
+    // the byte counts and the error
+    results
+    invoke(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        int (*fn)(z_streamp, int),
+        int flush)
+    {
+        results rv;
+        auto const n0 = clamp(in.size());
+        auto const n1 = clamp(out.size());
+        zs_.next_in = static_cast<Bytef*>(
+            const_cast<void*>(in.data()));
+        zs_.avail_in = n0;
+        zs_.next_out = static_cast<
+            Bytef*>(out.data());
+        zs_.avail_out = n1;
+        auto const ret = fn(&zs_, flush);
+        rv.in_bytes = n0 - zs_.avail_in;
+        rv.out_bytes = n1 - zs_.avail_out;
+        if(ret == Z_STREAM_END)
+        {
+            rv.finished = true;
+            return rv;
+        }
+        // Z_BUF_ERROR only means that no
+        // progress was possible this time.
+        if( ret != Z_OK &&
+            ret != Z_BUF_ERROR)
+            rv.ec = static_cast<error>(ret);
+        return rv;
+    }
+
+    z_stream_s zs_{};
+
+private:
+    static
+    uInt
+    clamp(std::size_t n) noexcept
+    {
+        if(n > (std::numeric_limits<
+                uInt>::max)())
+            return (std::numeric_limits<
+                uInt>::max)();
+        return static_cast<uInt>(n);
+    }
+
+    static void* zalloc(void* opaque,
+        uInt num, uInt size)
+    {
+        auto& self =
+            *reinterpret_cast<
+                zlib_filter*>(opaque);
+        std::size_t n =
+            std::size_t(num) * size;
+        // keep the next allocation aligned
+        n = (n + slack - 1) & ~(slack - 1);
+        if(n > self.n_)
+            return Z_NULL;
+        auto p = self.p_;
+        self.p_ += n;
+        self.n_ -= n;
+        return p;
+    }
+
+    static void zfree(
+        void*, void*)
+    {
+        // owned by the workspace
+    }
+
+    unsigned char* p_;
+    std::size_t n_;
+};
+
+//------------------------------------------------
+
+// Inflates a zlib or gzip stream.
+class inflate_filter
+    : public zlib_filter
+{
+public:
+    // the state and the window
+    static constexpr std::size_t allocations = 2;
+
+    inflate_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size,
+        int window_bits)
+        : zlib_filter(ws, block_size)
+    {
+        system::error_code ec =
+            static_cast<error>(
+                inflateInit2(&zs_,
+                    window_bits));
+        if(ec.failed())
+            http_proto::detail::throw_system_error(ec);
+    }
+
+private:
+    results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override
+    {
+        (void)more;
+        return invoke(out, in,
+            &inflate, Z_NO_FLUSH);
+    }
+};
+
+//------------------------------------------------
+
+// Deflates into a zlib or gzip stream.
+class deflate_filter
+    : public zlib_filter
+{
+public:
+    // the state, window, prev,
+    // head, and pending buffers
+    static constexpr std::size_t allocations = 5;
+
+    deflate_filter(
+        http_proto::detail::workspace& ws,
+        std::size_t block_size,
+        int level,
+        int window_bits,
+        int mem_level)
+        : zlib_filter(ws, block_size)
+    {
+        system::error_code ec =
+            static_cast<error>(
+                deflateInit2(&zs_,
+                    level,
+                    Z_DEFLATED,
+                    window_bits,
+                    mem_level,
+                    Z_DEFAULT_STRATEGY));
+        if(ec.failed())
+            http_proto::detail::throw_system_error(ec);
+    }
+
+private:
+    results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override
+    {
+        // Z_FINISH may be repeated until all
+        // of the output has been delivered.
+        return invoke(out, in,
+            &deflate, more ?
+                Z_NO_FLUSH : Z_FINISH);
+    }
+};
+
+//------------------------------------------------
+
 struct
     deflate_decoder_service_impl
     : deflate_decoder_service
@@ -228,14 +445,44 @@ struct
         : cfg_(cfg)
     {
         (void)ctx;
+        // zlib accepts 8 through 15
+        if( cfg_.max_window_bits < 8 ||
+            cfg_.max_window_bits > 15)
+            http_proto::detail::throw_invalid_argument();
+
+        // the state, and the window which
+        // inflate allocates on first use
         probe p;
-        auto n0 = p.deflate_init(
-            Z_DEFAULT_COMPRESSION).value();
-        (void)n0;
+        block_size_ =
+            p.inflate_init2(
+                window_bits()).value() +
+            (std::size_t(1) <<
+                cfg_.max_window_bits) +
+            inflate_filter::allocations *
+                zlib_filter::slack;
+
+        // the filter, the block, and the
+        // header and padding of the block
+        space_needed_ =
+            http_proto::detail::workspace::
+                space_needed<inflate_filter>() +
+            block_size_ +
+            4 * alignof(::max_align_t);
     }
 
 private:
     config cfg_;
+    std::size_t block_size_ = 0;
+    std::size_t space_needed_ = 0;
+
+    // adding 32 detects zlib
+    // and gzip headers both
+    int
+    window_bits() const noexcept
+    {
+        return static_cast<int>(
+            cfg_.max_window_bits) + 32;
+    }
 
     config const&
     get_config() const noexcept override
@@ -246,16 +493,118 @@ private:
     std::size_t
     space_needed() const noexcept override
     {
-        return 0;
+        return space_needed_;
     }
 
     filter&
     make_filter(http_proto::detail::workspace& ws) const override
     {
-        filter* p;
-        (void)ws;
-        p = nullptr;
-        return *p;
+        return ws.emplace<inflate_filter>(
+            ws, block_size_, window_bits());
+    }
+};
+
+//------------------------------------------------
+
+struct
+    deflate_encoder_service_impl
+    : deflate_encoder_service
+{
+    using key_type =
+        deflate_encoder_service;
+
+    explicit
+    deflate_encoder_service_impl(
+        context& ctx,
+        config const& cfg)
+        : cfg_(cfg)
+    {
+        (void)ctx;
+        // zlib accepts levels 0 through 9,
+        // windows 9 through 15, and
+        // memory levels 1 through 9.
+        if( cfg_.level > 9 ||
+            cfg_.window_bits < 9 ||
+            cfg_.window_bits > 15 ||
+            cfg_.mem_level < 1 ||
+            cfg_.mem_level > 9)
+            http_proto::detail::throw_invalid_argument();
+
+        // deflate allocates everything up
+        // front, and the gzip wrapper does
+        // not change the amount.
+        probe p;
+        block_size_ =
+            p.deflate_init2(
+                level(),
+                Z_DEFLATED,
+                window_bits(false),
+                mem_level(),
+                Z_DEFAULT_STRATEGY).value() +
+            deflate_filter::allocations *
+                zlib_filter::slack;
+
+        // the filter, the block, and the
+        // header and padding of the block
+        space_needed_ =
+            http_proto::detail::workspace::
+                space_needed<deflate_filter>() +
+            block_size_ +
+            4 * alignof(::max_align_t);
+    }
+
+private:
+    config cfg_;
+    std::size_t block_size_ = 0;
+    std::size_t space_needed_ = 0;
+
+    int
+    level() const noexcept
+    {
+        return static_cast<int>(
+            cfg_.level);
+    }
+
+    // adding 16 writes a gzip
+    // header and trailer
+    int
+    window_bits(bool gzip) const noexcept
+    {
+        return static_cast<int>(
+            cfg_.window_bits) +
+                (gzip ? 16 : 0);
+    }
+
+    int
+    mem_level() const noexcept
+    {
+        return static_cast<int>(
+            cfg_.mem_level);
+    }
+
+    config const&
+    get_config() const noexcept override
+    {
+        return cfg_;
+    }
+
+    std::size_t
+    space_needed() const noexcept override
+    {
+        return space_needed_;
+    }
+
+    filter&
+    make_filter(
+        http_proto::detail::workspace& ws,
+        bool gzip) const override
+    {
+        return ws.emplace<deflate_filter>(
+            ws,
+            block_size_,
+            level(),
+            window_bits(gzip),
+            mem_level());
     }
 };
 
@@ -270,6 +619,15 @@ install(context& ctx)
         detail::deflate_decoder_service_impl>(*this);
 }
 
+void
+deflate_encoder_service::
+config::
+install(context& ctx)
+{
+    ctx.make_service<
+        detail::deflate_encoder_service_impl>(*this);
+}
+
 } // zlib
 } // http_proto
 } // boost
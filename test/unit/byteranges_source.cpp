@@ -0,0 +1,236 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/byteranges_source.hpp>
+
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct byteranges_source_test
+{
+    std::string path_;
+    std::string body_;
+
+    file
+    open()
+    {
+        file f;
+        system::error_code ec;
+        f.open(path_.c_str(),
+            file_mode::scan, ec);
+        BOOST_TEST(! ec.failed());
+        return f;
+    }
+
+    // read everything, `step` bytes at a time
+    static
+    std::string
+    read(
+        byteranges_source& src,
+        std::size_t step)
+    {
+        std::string s;
+        std::string buf(step, 0);
+        for(;;)
+        {
+            auto rv = src.read(
+                buffers::mutable_buffer(
+                    &buf[0], buf.size()));
+            BOOST_TEST(! rv.ec.failed());
+            s.append(buf.data(), rv.bytes);
+            if(rv.finished)
+                break;
+            BOOST_TEST_EQ(rv.bytes, step);
+        }
+        return s;
+    }
+
+    std::string
+    part(
+        core::string_view type,
+        std::uint64_t first,
+        std::uint64_t last)
+    {
+        std::string s = "--XYZ\r\n";
+        if(! type.empty())
+        {
+            s += "Content-Type: ";
+            s += type;
+            s += "\r\n";
+        }
+        s += "Content-Range: bytes " +
+            std::to_string(first) + "-" +
+            std::to_string(last) + "/" +
+            std::to_string(body_.size()) + "\r\n\r\n";
+        s += body_.substr(first, last - first + 1);
+        return s;
+    }
+
+    void
+    testRead()
+    {
+        auto const expected =
+            part("text/plain", 0, 9) + "\r\n" +
+            part("text/plain", 500, 4999) + "\r\n" +
+            part("text/plain", body_.size() - 1,
+                body_.size() - 1) + "\r\n" +
+            "--XYZ--\r\n";
+
+        for(std::size_t step : { 1, 7, 4096, 65536 })
+        {
+            byteranges_source src(open(),
+                body_.size(), {
+                    { 0, 9 },
+                    { 500, 4999 },
+                    { body_.size() - 1,
+                        body_.size() - 1 } },
+                "text/plain", "XYZ");
+            BOOST_TEST_EQ(src.content_length(),
+                expected.size());
+            BOOST_TEST_EQ(read(src, step), expected);
+        }
+
+        // no content type, ranges out of order
+        {
+            byteranges_source src(open(),
+                body_.size(), {
+                    { 20, 29 },
+                    { 0, 4 } },
+                "", "XYZ");
+            auto const s =
+                part("", 20, 29) + "\r\n" +
+                part("", 0, 4) + "\r\n" +
+                "--XYZ--\r\n";
+            BOOST_TEST_EQ(src.content_length(), s.size());
+            BOOST_TEST_EQ(read(src, 100), s);
+        }
+
+        // file shorter than the range
+        {
+            byteranges_source src(open(),
+                body_.size() + 10, {
+                    { body_.size() - 5,
+                        body_.size() + 5 } },
+                "", "XYZ");
+            char buf[1000];
+            auto rv = src.read(
+                buffers::mutable_buffer(
+                    buf, sizeof(buf)));
+            BOOST_TEST(rv.ec == error::incomplete);
+        }
+    }
+
+    void
+    testSerialize()
+    {
+        byteranges_source src(open(),
+            body_.size(), {
+                { 100, 199 },
+                { 8000, 9999 } },
+            "application/octet-stream", "XYZ");
+        auto const expected =
+            part("application/octet-stream",
+                100, 199) + "\r\n" +
+            part("application/octet-stream",
+                8000, 9999) + "\r\n" +
+            "--XYZ--\r\n";
+
+        response res(status::partial_content);
+        res.set(field::content_type,
+            "multipart/byteranges; boundary=XYZ");
+        res.set_content_length(
+            src.content_length());
+        serializer sr(1024);
+        sr.start<byteranges_source>(
+            res, std::move(src));
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto const cbs = sr.prepare().value();
+            auto const n = buffers::buffer_size(cbs);
+            auto const n0 = s.size();
+            s.resize(n0 + n);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &s[n0], n), cbs);
+            sr.consume(n);
+        }
+        BOOST_TEST_EQ(s,
+            std::string(res.buffer()) + expected);
+    }
+
+    void
+    testErrors()
+    {
+        auto const make =
+            [&](std::vector<
+                byteranges_source::range> v,
+                core::string_view boundary)
+            {
+                byteranges_source src(open(),
+                    body_.size(), std::move(v),
+                    "", boundary);
+            };
+        BOOST_TEST_THROWS(make({}, "XYZ"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(make({ { 5, 4 } }, "XYZ"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(make({ { 0,
+            body_.size() } }, "XYZ"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(make({ { 0, 1 } }, ""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(make({ { 0, 1 } },
+            std::string(71, 'x')),
+            std::invalid_argument);
+    }
+
+    void
+    run()
+    {
+        path_ = boost::filesystem::
+            unique_path().string();
+        for(std::size_t i = 0; i < 20000; ++i)
+            body_.push_back(
+                "0123456789abcdef"[i % 16 ^ i / 4096]);
+        {
+            file f;
+            system::error_code ec;
+            f.open(path_.c_str(),
+                file_mode::write, ec);
+            BOOST_TEST(! ec.failed());
+            f.write(body_.data(), body_.size(), ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        testRead();
+        testSerialize();
+        testErrors();
+
+        boost::filesystem::remove(path_);
+    }
+};
+
+TEST_SUITE(
+    byteranges_source_test,
+    "boost.http_proto.byteranges_source");
+
+} // http_proto
+} // boost
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/context.hpp>
 
+#include <stdexcept>
+
 #include "test_suite.hpp"
 
 namespace boost {
@@ -17,19 +19,89 @@ namespace http_proto {
 
 struct context_test
 {
+    struct a_service : service
+    {
+        explicit
+        a_service(context&) noexcept
+        {
+        }
+    };
+
+    struct b_service : service
+    {
+        explicit
+        b_service(context&) noexcept
+        {
+        }
+    };
+
+    struct c_base : service
+    {
+    };
+
+    struct c_service : c_base
+    {
+        using key_type = c_base;
+
+        explicit
+        c_service(context&) noexcept
+        {
+        }
+    };
+
     void
     testContext()
     {
         // default construction
         {
             context ctx;
+            BOOST_TEST(! ctx.is_frozen());
         }
     }
 
+    void
+    testFreeze()
+    {
+        context ctx;
+        auto& a = ctx.make_service<a_service>();
+        auto& c = ctx.make_service<c_service>();
+        BOOST_TEST_EQ(ctx.find_service<a_service>(), &a);
+        BOOST_TEST_EQ(ctx.find_service<c_base>(), &c);
+
+        ctx.freeze();
+        BOOST_TEST(ctx.is_frozen());
+        BOOST_TEST_EQ(ctx.find_service<a_service>(), &a);
+        BOOST_TEST_EQ(ctx.find_service<c_base>(), &c);
+        BOOST_TEST_EQ(ctx.find_service<c_service>(), &c);
+        BOOST_TEST_EQ(&ctx.get_service<a_service>(), &a);
+        BOOST_TEST(! ctx.has_service<b_service>());
+        BOOST_TEST_THROWS(
+            ctx.get_service<b_service>(),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            ctx.make_service<b_service>(),
+            std::logic_error);
+
+        // no further effect
+        ctx.freeze();
+        BOOST_TEST_EQ(ctx.find_service<a_service>(), &a);
+
+        // each context has its own table
+        context ctx2;
+        auto& b = ctx2.make_service<b_service>();
+        ctx2.freeze();
+        BOOST_TEST_EQ(ctx2.find_service<b_service>(), &b);
+        BOOST_TEST_EQ(
+            ctx2.find_service<a_service>(), nullptr);
+        BOOST_TEST_EQ(
+            ctx.find_service<b_service>(), nullptr);
+    }
+
     void
     run()
     {
         testContext();
+        testFreeze();
     }
 };
 
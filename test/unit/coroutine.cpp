@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/coroutine.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_CO_AWAIT
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/loopback_stream.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/string_buffer.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct coroutine_test
+{
+    // reads one message, with the
+    // body stored in `body`
+    static
+    task<system::error_code>
+    read_message(
+        loopback_stream& s,
+        request_parser& pr,
+        std::string& body)
+    {
+        pr.start();
+        auto ec = co_await co_read_header(s, pr);
+        if(ec.failed())
+            co_return ec;
+        body.clear();
+        pr.set_body(buffers::string_buffer(&body));
+        co_return co_await co_read_body(s, pr);
+    }
+
+    static
+    task<int>
+    throws()
+    {
+        throw std::runtime_error("");
+        co_return 0;
+    }
+
+    static
+    task<int>
+    nested(int n)
+    {
+        if(n == 0)
+            co_return 0;
+        co_return 1 + co_await nested(n - 1);
+    }
+
+    void
+    testTask()
+    {
+        BOOST_TEST_EQ(run_inline(nested(100)), 100);
+        BOOST_TEST_THROWS(run_inline(throws()),
+            std::runtime_error);
+    }
+
+    void
+    testMessages()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        serializer sr(1024);
+
+        // partial reads and writes
+        for(std::size_t step : { 1, 7, 4096 })
+        {
+            loopback_stream s(step, step);
+            pr.reset();
+            std::string const body0 = "Hello, world!";
+            std::string const body1(5000, '*');
+            for(auto const& b : { body0, body1 })
+            {
+                request req;
+                req.set_method(method::post);
+                req.set_target("/");
+                req.set_content_length(b.size());
+                sr.reset();
+                sr.start(req, buffers::const_buffer(
+                    b.data(), b.size()));
+                BOOST_TEST(! run_inline(
+                    co_write_message(s, sr)).failed());
+            }
+
+            // pipelined
+            std::string body;
+            BOOST_TEST(! run_inline(read_message(
+                s, pr, body)).failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(body, body0);
+            BOOST_TEST(! run_inline(read_message(
+                s, pr, body)).failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(body, body1);
+            BOOST_TEST(s.data().empty());
+
+            // stream ends between messages
+            pr.start();
+            BOOST_TEST(run_inline(
+                co_read_header(s, pr)) ==
+                    error::end_of_stream);
+        }
+
+        // stream ends within a message
+        {
+            loopback_stream s;
+            s.append(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "abc");
+            pr.reset();
+            pr.start();
+            BOOST_TEST(! run_inline(
+                co_read_header(s, pr)).failed());
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST(run_inline(
+                co_read_body(s, pr)) ==
+                    error::incomplete);
+        }
+    }
+
+    void
+    run()
+    {
+        testTask();
+        testMessages();
+    }
+};
+
+TEST_SUITE(
+    coroutine_test,
+    "boost.http_proto.coroutine");
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/digest.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <algorithm>
+#include <string>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct digest_test
+{
+    struct string_sink : sink
+    {
+        std::string* s_;
+
+        explicit
+        string_sink(
+            std::string* s) noexcept
+            : s_(s)
+        {
+        }
+
+        results
+        on_write(
+            buffers::const_buffer b,
+            bool) override
+        {
+            results rv;
+            s_->append(static_cast<
+                char const*>(b.data()), b.size());
+            rv.bytes = b.size();
+            return rv;
+        }
+    };
+
+    struct string_source : source
+    {
+        core::string_view s_;
+
+        explicit
+        string_source(
+            core::string_view s) noexcept
+            : s_(s)
+        {
+        }
+
+        results
+        on_read(
+            buffers::mutable_buffer b) override
+        {
+            results rv;
+            rv.bytes = buffers::buffer_copy(b,
+                buffers::const_buffer(
+                    s_.data(), s_.size()));
+            s_.remove_prefix(rv.bytes);
+            rv.finished = s_.empty();
+            return rv;
+        }
+    };
+
+    template<class Digest>
+    static
+    std::string
+    hex(Digest const& d)
+    {
+        static constexpr char digits[] =
+            "0123456789abcdef";
+        std::string s;
+        for(unsigned char c : d.digest())
+        {
+            s += digits[c >> 4];
+            s += digits[c & 0xf];
+        }
+        return s;
+    }
+
+    // feed `s` in pieces of `step` bytes
+    template<class Digest>
+    static
+    std::string
+    hex(
+        core::string_view s,
+        std::size_t step)
+    {
+        Digest d;
+        while(! s.empty())
+        {
+            auto const n =
+                (std::min)(s.size(), step);
+            d.update(s.data(), n);
+            s.remove_prefix(n);
+        }
+        return hex(d);
+    }
+
+    void
+    testCrc32c()
+    {
+        {
+            crc32c c;
+            BOOST_TEST_EQ(c.value(), 0u);
+            c.update("123456789", 9);
+            BOOST_TEST_EQ(c.value(), 0xe3069283u);
+            BOOST_TEST_EQ(hex(c), "e3069283");
+        }
+        {
+            crc32c c;
+            c.update(buffers::const_buffer(
+                "hello world", 11));
+            BOOST_TEST_EQ(c.value(), 0xc99465aau);
+        }
+
+        // any split gives the same result
+        std::string s;
+        for(std::size_t i = 0; i < 1000; ++i)
+            s += static_cast<char>(i * 7);
+        auto const h = hex<crc32c>(s, s.size());
+        for(std::size_t step : { 1, 3, 4, 7, 8, 13, 64 })
+            BOOST_TEST_EQ(hex<crc32c>(s, step), h);
+    }
+
+    void
+    testSha256()
+    {
+        BOOST_TEST_EQ(hex(sha256()),
+            "e3b0c44298fc1c149afbf4c8996fb924"
+            "27ae41e4649b934ca495991b7852b855");
+        BOOST_TEST_EQ(hex<sha256>("abc", 3),
+            "ba7816bf8f01cfea414140de5dae2223"
+            "b00361a396177a9cb410ff61f20015ad");
+
+        // two blocks of padding
+        core::string_view const s =
+            "abcdbcdecdefdefgefghfghighijhijk"
+            "ijkljklmklmnlmnomnopnopq";
+        for(std::size_t step : { 1, 5, 56, 64 })
+            BOOST_TEST_EQ(hex<sha256>(s, step),
+                "248d6a61d20638b8e5c026930c3e6039"
+                "a33ce45964ff2167f6ecedd419db06c1");
+
+        BOOST_TEST_EQ(hex<sha256>(
+            std::string(1000000, 'a'), 77),
+            "cdc76e5c9914fb9281a1c7e284d73e67"
+            "f1809a48a497200e046d39ccc7112cd0");
+
+        // taking the digest does
+        // not end the computation
+        {
+            sha256 h;
+            h.update("a", 1);
+            hex(h);
+            h.update("bc", 2);
+            BOOST_TEST_EQ(hex(h),
+                "ba7816bf8f01cfea414140de5dae2223"
+                "b00361a396177a9cb410ff61f20015ad");
+        }
+    }
+
+    void
+    testSink()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+
+        // the checksum arrives after the body
+        core::string_view const s =
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\nhello\r\n"
+            "6\r\n world\r\n"
+            "0\r\n"
+            "Digest: crc32c=c99465aa\r\n"
+            "\r\n";
+        pr.commit(buffers::buffer_copy(
+            pr.prepare(),
+            buffers::const_buffer(
+                s.data(), s.size())));
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(pr.got_header());
+
+        std::string body;
+        auto& ds = pr.set_body(
+            digest_sink<crc32c, string_sink>(
+                string_sink(&body)));
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(body, "hello world");
+        BOOST_TEST_EQ(ds.hash().value(), 0xc99465aau);
+        BOOST_TEST_EQ(
+            pr.trailers().value_or("Digest", ""),
+            "crc32c=" + hex(ds.hash()));
+    }
+
+    void
+    testSource()
+    {
+        response res;
+        res.set_chunked(true);
+        serializer sr(1024);
+        auto& src = sr.start<
+            digest_source<sha256, string_source>>(
+                res, "hello world");
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto const cbs = sr.prepare().value();
+            auto const n = buffers::buffer_size(cbs);
+            auto const n0 = s.size();
+            s.resize(n0 + n);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &s[n0], n), cbs);
+            sr.consume(n);
+        }
+        BOOST_TEST_EQ(hex(src.hash()),
+            "b94d27b9934d3e08a52e52d7da7dabfa"
+            "c484efe37a5380ee9088f7ace2efcde9");
+    }
+
+    void
+    run()
+    {
+        testCrc32c();
+        testSha256();
+        testSink();
+        testSource();
+    }
+};
+
+TEST_SUITE(
+    digest_test,
+    "boost.http_proto.digest");
+
+} // http_proto
+} // boost
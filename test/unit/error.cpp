@@ -75,8 +75,10 @@ public:
         check(n, error::end_of_stream);
         check(n, error::in_place_overflow);
         check(n, error::need_data);
+        check(n, error::need_file);
 
         check(n, error::bad_connection);
+        check(n, error::bad_content_encoding);
         check(n, error::bad_content_length);
         check(n, error::bad_expect);
         check(n, error::bad_field_name);
@@ -85,6 +87,7 @@ public:
         check(n, error::bad_line_ending);
         check(n, error::bad_list);
         check(n, error::bad_method);
+        check(n, error::bad_multipart);
         check(n, error::bad_number);
         check(n, error::bad_payload);
         check(n, error::bad_version);
@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/detail/sv.hpp>
 #include <boost/url/grammar/ci_string.hpp>
+#include <string>
 
 #include "test_suite.hpp"
 
@@ -400,11 +401,38 @@ public:
             };
         unknown("");
         unknown("x");
+        unknown("C");
+        unknown("Ccc");
+        unknown("Content-Locatio");
+        unknown("Content-Locationn");
+        unknown("Content-Lxcation");
+        unknown("Access-Control-Allow-Origin-");
+        unknown("Access-Control-Allow-Origim");
+    }
+
+    void
+    testRoundTrip()
+    {
+        // every name in the table, in any case
+        for(unsigned i = 1; i <=
+            static_cast<unsigned>(field::xref); ++i)
+        {
+            auto const f = static_cast<field>(i);
+            std::string s(to_string(f));
+            BOOST_TEST(string_to_field(s) == f);
+            for(auto& c : s)
+                c = grammar::to_lower(c);
+            BOOST_TEST(string_to_field(s) == f);
+            for(auto& c : s)
+                c = grammar::to_upper(c);
+            BOOST_TEST(string_to_field(s) == f);
+        }
     }
 
     void run()
     {
         testField();
+        testRoundTrip();
     }
 };
 
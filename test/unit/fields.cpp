@@ -433,12 +433,207 @@ struct fields_test
         }
     }
 
+    void
+    testResource()
+    {
+        core::string_view const cs =
+            "Connection: close\r\n"
+            "Set-Cookie: 0\r\n"
+            "User-Agent: boost\r\n"
+            "\r\n";
+
+        // storage comes from the resource
+        {
+            test_resource mr;
+            {
+                fields f(mr);
+                BOOST_TEST(f.resource() == &mr);
+                BOOST_TEST_EQ(mr.allocs, 0U);
+                f.append(field::connection, "close");
+                f.append(field::set_cookie, "0");
+                f.append(field::user_agent, "boost");
+                test_fields(f, cs);
+                BOOST_TEST_GT(mr.allocs, 0U);
+                BOOST_TEST_EQ(
+                    mr.bytes, f.capacity_in_bytes());
+                f.shrink_to_fit();
+                BOOST_TEST(f.resource() == &mr);
+                BOOST_TEST_EQ(
+                    mr.bytes, f.capacity_in_bytes());
+                f.reserve_bytes(4096);
+                BOOST_TEST_EQ(
+                    mr.bytes, f.capacity_in_bytes());
+                test_fields(f, cs);
+            }
+            BOOST_TEST_EQ(mr.bytes, 0U);
+        }
+
+        // copies use the heap
+        {
+            test_resource mr;
+            fields f0(mr);
+            f0.append(field::connection, "close");
+            auto const n = mr.allocs;
+            fields f1(f0);
+            BOOST_TEST(f1.resource() == nullptr);
+            BOOST_TEST_EQ(mr.allocs, n);
+            BOOST_TEST_EQ(f1.buffer(), f0.buffer());
+        }
+
+        // copy assignment keeps the resource
+        {
+            test_resource mr;
+            {
+                fields f0(cs);
+                fields f1(mr);
+                f1 = f0;
+                BOOST_TEST(f1.resource() == &mr);
+                BOOST_TEST_GT(mr.bytes, 0U);
+                test_fields(f1, cs);
+            }
+            BOOST_TEST_EQ(mr.bytes, 0U);
+        }
+
+        // move construction takes the resource
+        {
+            test_resource mr;
+            {
+                fields f0(mr);
+                f0.append(field::connection, "close");
+                auto const n = mr.allocs;
+                fields f1(std::move(f0));
+                BOOST_TEST(f1.resource() == &mr);
+                BOOST_TEST(f0.resource() == &mr);
+                BOOST_TEST_EQ(mr.allocs, n);
+
+                fields f2(mr);
+                f2.append(field::set_cookie, "0");
+                swap(f1, f2);
+                BOOST_TEST_EQ(f1.buffer(),
+                    "Set-Cookie: 0\r\n\r\n");
+                BOOST_TEST_EQ(f2.buffer(),
+                    "Connection: close\r\n\r\n");
+            }
+            BOOST_TEST_EQ(mr.bytes, 0U);
+        }
+
+        // move assignment copies
+        // from another resource
+        {
+            test_resource mr;
+            fields f1(cs);
+            {
+                fields f0(mr);
+                f0.append(field::connection, "close");
+                auto const n = mr.allocs;
+                f1 = std::move(f0);
+                BOOST_TEST(f1.resource() == nullptr);
+                BOOST_TEST_EQ(mr.allocs, n);
+            }
+            BOOST_TEST_EQ(mr.bytes, 0U);
+            BOOST_TEST_EQ(f1.buffer(),
+                "Connection: close\r\n\r\n");
+
+            fields f2(mr);
+            f2 = std::move(f1);
+            BOOST_TEST(f2.resource() == &mr);
+            BOOST_TEST_EQ(
+                mr.bytes, f2.capacity_in_bytes());
+            BOOST_TEST_EQ(f2.buffer(),
+                "Connection: close\r\n\r\n");
+        }
+    }
+
+    void
+    testAppendList()
+    {
+        core::string_view const cs =
+            "Host: example.com\r\n"
+            "User-Agent: boost\r\n"
+            "Accept:\r\n"
+            "Connection: close\r\n"
+            "\r\n";
+
+        {
+            fields f;
+            BOOST_TEST(! f.append({
+                { field::host, "example.com" },
+                { field::user_agent, " boost\t" },
+                { field::accept, "" },
+                { field::connection, "close" } }
+                    ).has_error());
+            test_fields(f, cs);
+            BOOST_TEST(f.exists(field::connection));
+            BOOST_TEST(! f.append({}).has_error());
+            test_fields(f, cs);
+        }
+
+        // after other fields, without
+        // reallocating
+        {
+            fields f;
+            f.reserve_bytes(1024);
+            auto const p = f.buffer().data();
+            f.append(field::host, "example.com");
+            BOOST_TEST(! f.append({
+                { field::user_agent, "boost" },
+                { field::accept, "" },
+                { field::connection, "close" } }
+                    ).has_error());
+            test_fields(f, cs);
+            BOOST_TEST_EQ(f.buffer().data(), p);
+        }
+
+        // one allocation
+        {
+            test_resource mr;
+            fields f(mr);
+            f.append({
+                { field::host, "example.com" },
+                { field::user_agent, "boost" },
+                { field::accept, "" },
+                { field::connection, "close" } });
+            test_fields(f, cs);
+            BOOST_TEST_EQ(mr.allocs, 1U);
+        }
+
+        // bad value leaves the fields unchanged
+        {
+            fields f(cs);
+            auto rv = f.append({
+                { field::server, "boost" },
+                { field::age, "1\r\n2" } });
+            BOOST_TEST(rv.has_error());
+            test_fields(f, cs);
+            BOOST_TEST(! f.exists(field::server));
+            f.append({
+                { field::server, "boost" } });
+            BOOST_TEST_EQ(f.value_or(
+                field::server, ""), "boost");
+        }
+    }
+
+    void
+    testGrowth()
+    {
+        // appends reallocate geometrically
+        test_resource mr;
+        fields f(mr);
+        for(int i = 0; i < 1000; ++i)
+            f.append(field::user_agent, "boost");
+        BOOST_TEST_EQ(f.size(), 1000U);
+        BOOST_TEST_LE(mr.allocs, 20U);
+    }
+
     void
     run()
     {
         testSpecial();
         testObservers();
         testInitialSize();
+        testResource();
+        testAppendList();
+        testGrowth();
     }
 };
 
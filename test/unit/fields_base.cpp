@@ -1378,6 +1378,85 @@ struct fields_base_test
         }
     }
 
+    void
+    testIndex()
+    {
+        // lookups stay correct as the
+        // set of present fields changes
+        fields f;
+        BOOST_TEST(! f.exists(field::host));
+        BOOST_TEST_EQ(f.count(field::host), 0);
+        BOOST_TEST(f.find(field::host) == f.end());
+
+        f.append(field::host, "x");
+        f.append("X-Custom", "1");
+        f.append(field::cookie, "a");
+        f.append(field::cookie, "b");
+        BOOST_TEST(f.exists(field::host));
+        BOOST_TEST(f.exists("HOST"));
+        BOOST_TEST(f.exists("x-custom"));
+        BOOST_TEST_EQ(f.count(field::cookie), 2);
+        BOOST_TEST_EQ(f.count("Cookie"), 2);
+        BOOST_TEST_EQ(
+            f.find_last(f.end(), field::cookie)->value,
+            "b");
+        BOOST_TEST(! f.exists(field::authorization));
+
+        // names which are not tokens never
+        // match a known field
+        f.append(field::content_length, "1");
+        BOOST_TEST(f.find("Content\rLength") == f.end());
+        BOOST_TEST(f.find("content-length") != f.end());
+        BOOST_TEST_EQ(f.count("Content\rLength"), 0);
+        BOOST_TEST(! f.exists("Content\rLength"));
+        BOOST_TEST_EQ(f.erase(field::content_length), 1);
+
+        // erase one of two
+        f.erase(f.find(field::cookie));
+        BOOST_TEST_EQ(f.count(field::cookie), 1);
+        BOOST_TEST_EQ(f.value_or(field::cookie, ""), "b");
+
+        // erase the last one singly
+        f.erase(f.find(field::host));
+        BOOST_TEST(! f.exists(field::host));
+        BOOST_TEST(f.find("Host") == f.end());
+        f.append(field::host, "y");
+        BOOST_TEST_EQ(f.value_or(field::host, ""), "y");
+
+        // erase all
+        BOOST_TEST_EQ(f.erase(field::cookie), 1);
+        BOOST_TEST(! f.exists(field::cookie));
+        f.append(field::cookie, "c");
+        BOOST_TEST_EQ(f.value_or("cookie", ""), "c");
+        BOOST_TEST_EQ(f.erase("COOKIE"), 1);
+        BOOST_TEST(! f.exists(field::cookie));
+
+        // set
+        f.set(field::authorization, "token");
+        BOOST_TEST_EQ(
+            f.value_or(field::authorization, ""),
+            "token");
+
+        // copy, swap and clear
+        fields f1(f);
+        BOOST_TEST(f1.exists(field::authorization));
+        fields f2;
+        f2.swap(f1);
+        BOOST_TEST(! f1.exists(field::authorization));
+        BOOST_TEST(f2.exists(field::authorization));
+        f2.clear();
+        BOOST_TEST(! f2.exists(field::authorization));
+        BOOST_TEST(! f2.exists(field::host));
+
+        // special fields counted by metadata
+        request req;
+        req.append(field::connection, "close");
+        req.append(field::connection, "upgrade");
+        BOOST_TEST_EQ(req.count(field::connection), 2);
+        req.erase(field::connection);
+        BOOST_TEST_EQ(req.count(field::connection), 0);
+    }
+
     void
     run()
     {
@@ -1387,6 +1466,7 @@ struct fields_base_test
         testErase();
         testSet();
         testExpect();
+        testIndex();
 
         test_suite::log <<
             "sizeof(detail::header) == " <<
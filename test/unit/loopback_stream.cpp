@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/loopback_stream.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_CO_AWAIT
+
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct loopback_stream_test
+{
+    void
+    run()
+    {
+        system::error_code ec;
+        char buf[16];
+        buffers::mutable_buffer const mb(
+            buf, sizeof(buf));
+
+        // limited transfers
+        {
+            loopback_stream s(3, 4);
+            auto w = s.write_some(
+                buffers::const_buffer(
+                    "abcdef", 6), ec);
+            BOOST_TEST(w.await_ready());
+            BOOST_TEST_EQ(w.await_resume(), 4u);
+            BOOST_TEST_EQ(s.data(), "abcd");
+            BOOST_TEST_EQ(s.read_some(
+                mb, ec).await_resume(), 3u);
+            BOOST_TEST_EQ(s.data(), "d");
+            BOOST_TEST_EQ(s.read_some(
+                mb, ec).await_resume(), 1u);
+            BOOST_TEST_EQ(buf[0], 'd');
+            BOOST_TEST(! ec.failed());
+        }
+
+        // end of stream
+        {
+            loopback_stream s;
+            s.append("xy");
+            BOOST_TEST_EQ(s.read_some(
+                mb, ec).await_resume(), 2u);
+            BOOST_TEST_EQ(s.read_some(
+                mb, ec).await_resume(), 0u);
+            BOOST_TEST(! ec.failed());
+        }
+    }
+};
+
+TEST_SUITE(
+    loopback_stream_test,
+    "boost.http_proto.loopback_stream");
+
+} // http_proto
+} // boost
+
+#endif
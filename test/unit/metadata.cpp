@@ -272,6 +272,112 @@ struct metadata_test
             { ok, 0, false, false, false});
     }
 
+    void
+    testContentEncoding()
+    {
+        auto const check = [](
+            core::string_view s,
+            void(*f)(message_base&),
+            metadata::content_encoding_t ce)
+        {
+            request req(s);
+            f(req);
+            auto const t =
+                req.metadata().content_encoding;
+            BOOST_TEST_EQ(t.ec, ce.ec);
+            BOOST_TEST_EQ(t.count, ce.count);
+            BOOST_TEST(t.encoding == ce.encoding);
+        };
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 0, encoding::identity });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: deflate\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::deflate });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: GZIP\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::gzip });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: x-gzip\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::gzip });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: br\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::br });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: compress\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::unknown });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: deflate, gzip\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, encoding::unknown });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 2, encoding::unknown });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: ,\r\n"
+            "\r\n",
+            [](message_base&){},
+            { error::bad_content_encoding, 1,
+                encoding::identity });
+
+        //----------------------------------------
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(field::content_encoding);
+            },
+            { ok, 0, encoding::identity });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Content-Encoding: compress\r\n"
+            "Content-Encoding: gzip\r\n"
+            "\r\n",
+            [](message_base& f)
+            {
+                f.erase(f.find(
+                    field::content_encoding));
+            },
+            { ok, 1, encoding::gzip });
+    }
+
     void
     testContentLength()
     {
@@ -423,6 +529,7 @@ struct metadata_test
             BOOST_TEST_EQ(t.count, te.count);
             BOOST_TEST_EQ(t.codings, te.codings);
             BOOST_TEST_EQ(t.is_chunked, te.is_chunked);
+            BOOST_TEST(t.encoding == te.encoding);
         };
 
         check(
@@ -488,35 +595,49 @@ struct metadata_test
             "Transfer-Encoding: compress\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 1, 1, false });
+            { ok, 1, 1, false, encoding::unknown });
 
         check(
             "GET / HTTP/1.1\r\n"
             "Transfer-Encoding: deflate\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 1, 1, false });
+            { ok, 1, 1, false, encoding::deflate });
 
         check(
             "GET / HTTP/1.1\r\n"
             "Transfer-Encoding: gzip\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 1, 1, false });
+            { ok, 1, 1, false, encoding::gzip });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: gzip, chunked\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, 2, true, encoding::gzip });
+
+        check(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: deflate, gzip, chunked\r\n"
+            "\r\n",
+            [](message_base&){},
+            { ok, 1, 3, true, encoding::unknown });
 
         check(
             "GET / HTTP/1.1\r\n"
             "Transfer-Encoding: custom;a=1\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 1, 1, false});
+            { ok, 1, 1, false, encoding::unknown });
 
         check(
             "GET / HTTP/1.1\r\n"
             "Transfer-Encoding: a,b,c\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 1, 3, false});
+            { ok, 1, 3, false, encoding::unknown });
 
         check(
             "GET / HTTP/1.1\r\n"
@@ -524,7 +645,7 @@ struct metadata_test
             "Transfer-Encoding: x,y\r\n"
             "\r\n",
             [](message_base&){},
-            { ok, 2, 5, false});
+            { ok, 2, 5, false, encoding::unknown });
 
         //----------------------------------------
 
@@ -583,7 +704,7 @@ struct metadata_test
             {
                 f.erase(f.find(field::transfer_encoding));
             },
-            { ok, 2, 2, true });
+            { ok, 2, 2, true, encoding::unknown });
 
         check(
             "GET / HTTP/1.1\r\n"
@@ -1200,6 +1321,7 @@ struct metadata_test
     {
         testSubrange();
         testConnection();
+        testContentEncoding();
         testContentLength();
         testTransferEncoding();
         testUpgrade();
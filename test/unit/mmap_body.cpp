@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/mmap_body.hpp>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct mmap_body_test
+{
+    std::string path_;
+    std::string body_;
+
+    file_posix
+    open(std::uint64_t offset)
+    {
+        file_posix f;
+        system::error_code ec;
+        f.open(path_.c_str(),
+            file_mode::scan, ec);
+        BOOST_TEST(! ec.failed());
+        f.seek(offset, ec);
+        BOOST_TEST(! ec.failed());
+        return f;
+    }
+
+    void
+    testData()
+    {
+        // rest of the file, one page per slice
+        {
+            mmap_body mb(open(0),
+                std::uint64_t(-1), 1);
+            BOOST_TEST_EQ(mb.size(), body_.size());
+            std::string s;
+            std::size_t slices = 0;
+            while(mb.size() > 0)
+            {
+                system::error_code ec;
+                auto const b = mb.data(ec);
+                BOOST_TEST(! ec.failed());
+                BOOST_TEST_GT(b.size(), 0u);
+                s.append(static_cast<
+                    char const*>(b.data()), b.size());
+                mb.consume(b.size());
+                ++slices;
+            }
+            BOOST_TEST_EQ(s, body_);
+            BOOST_TEST_GT(slices, 1u);
+        }
+
+        // size given, starting off a page boundary
+        {
+            mmap_body mb(open(4001), 5000, 1);
+            BOOST_TEST_EQ(mb.size(), 5000u);
+            std::string s;
+            while(mb.size() > 0)
+            {
+                system::error_code ec;
+                auto const b = mb.data(ec);
+                BOOST_TEST(! ec.failed());
+                // consume in small pieces
+                auto const n = (std::min)(
+                    b.size(), std::size_t(7));
+                s.append(static_cast<
+                    char const*>(b.data()), n);
+                mb.consume(n);
+            }
+            BOOST_TEST_EQ(s, body_.substr(4001, 5000));
+        }
+
+        // empty
+        {
+            mmap_body mb(open(body_.size()));
+            BOOST_TEST_EQ(mb.size(), 0u);
+            system::error_code ec;
+            BOOST_TEST_EQ(mb.data(ec).size(), 0u);
+            BOOST_TEST(! ec.failed());
+        }
+    }
+
+    void
+    testRead()
+    {
+        mmap_body mb(open(3), std::uint64_t(-1), 1);
+        std::string s;
+        char buf[1000];
+        for(;;)
+        {
+            auto rv = mb.read(
+                buffers::mutable_buffer(
+                    buf, sizeof(buf)));
+            BOOST_TEST(! rv.ec.failed());
+            s.append(buf, rv.bytes);
+            if(rv.finished)
+                break;
+        }
+        BOOST_TEST_EQ(s, body_.substr(3));
+    }
+
+    void
+    run()
+    {
+        path_ = boost::filesystem::
+            unique_path().string();
+        for(std::size_t i = 0; i < 20000; ++i)
+            body_.push_back(
+                "0123456789abcdef"[i % 16 ^ i / 4096]);
+        {
+            file_posix f;
+            system::error_code ec;
+            f.open(path_.c_str(),
+                file_mode::write, ec);
+            BOOST_TEST(! ec.failed());
+            f.write(body_.data(), body_.size(), ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        testData();
+        testRead();
+
+        boost::filesystem::remove(path_);
+    }
+};
+
+TEST_SUITE(
+    mmap_body_test,
+    "boost.http_proto.mmap_body");
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2023 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/multipart_sink.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct multipart_sink_test
+{
+    struct string_sink : sink
+    {
+        std::string s;
+        bool done = false;
+
+        results
+        on_write(
+            buffers::const_buffer b,
+            bool more) override
+        {
+            BOOST_TEST(! done);
+            s.append(static_cast<
+                char const*>(b.data()),
+                    b.size());
+            done = ! more;
+            results rv;
+            rv.bytes = b.size();
+            return rv;
+        }
+    };
+
+    // records the headers and body of
+    // each part, discarding the second
+    struct test_sink : multipart_sink
+    {
+        std::vector<std::string> headers;
+        std::vector<std::unique_ptr<
+            string_sink>> bodies;
+
+        using multipart_sink::multipart_sink;
+
+        sink*
+        on_part(fields_view const& f) override
+        {
+            headers.emplace_back(f.buffer());
+            bodies.emplace_back(new string_sink);
+            if(bodies.size() == 2)
+                return nullptr;
+            return bodies.back().get();
+        }
+    };
+
+    static
+    std::string const&
+    body()
+    {
+        static std::string const s =
+            "preamble\r\n"
+            "--AaB03x\r\n"
+            "Content-Disposition: form-data; name=\"a\"\r\n"
+            "\r\n"
+            "hello\r\n--AaB03\r\n--AaB03y--AaB\r\n"
+            "\r\n--AaB03x \t\r\n"
+            "Content-Type: text/plain\r\n"
+            "\r\n"
+            "discarded"
+            "\r\n--AaB03x\r\n"
+            "\r\n"
+            "x\r\r\n--"
+            "\r\n--AaB03x--\r\n"
+            "epilogue --AaB03x";
+        return s;
+    }
+
+    static
+    void
+    check(test_sink const& ts)
+    {
+        BOOST_TEST(ts.is_done());
+        BOOST_TEST_EQ(ts.count(), 3u);
+        if(! BOOST_TEST_EQ(ts.bodies.size(), 3u))
+            return;
+        BOOST_TEST_EQ(ts.headers[0],
+            "Content-Disposition: form-data; name=\"a\"\r\n"
+            "\r\n");
+        BOOST_TEST_EQ(ts.headers[1],
+            "Content-Type: text/plain\r\n"
+            "\r\n");
+        BOOST_TEST_EQ(ts.headers[2], "\r\n");
+        BOOST_TEST_EQ(ts.bodies[0]->s,
+            "hello\r\n--AaB03\r\n--AaB03y--AaB\r\n");
+        BOOST_TEST(ts.bodies[0]->done);
+        BOOST_TEST(ts.bodies[1]->s.empty());
+        BOOST_TEST_EQ(ts.bodies[2]->s, "x\r\r\n--");
+        BOOST_TEST(ts.bodies[2]->done);
+    }
+
+    void
+    testWrite()
+    {
+        auto const& s = body();
+
+        // every split into three writes
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        for(std::size_t j = i; j <= s.size(); ++j)
+        {
+            test_sink ts(
+                "multipart/form-data; boundary=AaB03x");
+            auto rv = ts.write(
+                buffers::const_buffer(
+                    s.data(), i), true);
+            rv += ts.write(
+                buffers::const_buffer(
+                    s.data() + i, j - i), true);
+            rv += ts.write(
+                buffers::const_buffer(
+                    s.data() + j, s.size() - j), false);
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST_EQ(rv.bytes, s.size());
+            check(ts);
+        }
+
+        // body begins with the delimiter
+        {
+            test_sink ts(
+                "Multipart/Mixed; charset=x; "
+                "BOUNDARY=\"a \\\"b\"");
+            BOOST_TEST_EQ(ts.boundary(), "a \"b");
+            std::string const s1 =
+                "--a \"b\r\n\r\nX\r\n--a \"b--";
+            auto rv = ts.write(buffers::const_buffer(
+                s1.data(), s1.size()), false);
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST_EQ(ts.count(), 1u);
+            if(BOOST_TEST_EQ(ts.bodies.size(), 1u))
+                BOOST_TEST_EQ(ts.bodies[0]->s, "X");
+        }
+
+        // no close delimiter
+        {
+            test_sink ts(
+                "multipart/form-data; boundary=AaB03x");
+            auto rv = ts.write(buffers::const_buffer(
+                s.data(), 60), false);
+            BOOST_TEST(rv.ec == error::incomplete);
+        }
+
+        // bad delimiter line
+        for(core::string_view s1 : {
+            "--AaB03x-x",
+            "--AaB03xy\r\n",
+            "--AaB03x\rx" })
+        {
+            test_sink ts(
+                "multipart/form-data; boundary=AaB03x");
+            auto rv = ts.write(buffers::const_buffer(
+                s1.data(), s1.size()), true);
+            BOOST_TEST(rv.ec == error::bad_multipart);
+        }
+    }
+
+    void
+    testParser()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+
+        std::string const s =
+            "POST /upload HTTP/1.1\r\n"
+            "Content-Type: multipart/form-data; boundary=AaB03x\r\n"
+            "Content-Length: " + std::to_string(
+                body().size()) + "\r\n"
+            "\r\n" + body();
+        std::size_t pos = 0;
+        test_sink* ts = nullptr;
+        while(! pr.is_complete())
+        {
+            system::error_code ec;
+            pr.parse(ec);
+            if( ts == nullptr &&
+                pr.got_header())
+            {
+                ts = &pr.set_body(test_sink(
+                    pr.get().value_or(
+                        field::content_type, "")));
+                continue;
+            }
+            if(pr.is_complete())
+                break;
+            if(! BOOST_TEST(
+                    ec == condition::need_more_input))
+                return;
+            auto const n = buffers::buffer_copy(
+                pr.prepare(), buffers::const_buffer(
+                    s.data() + pos, s.size() - pos));
+            pr.commit(n);
+            pos += n;
+        }
+        BOOST_TEST(pr.is_complete());
+        if(BOOST_TEST(ts != nullptr))
+            check(*ts);
+    }
+
+    void
+    testErrors()
+    {
+        BOOST_TEST_THROWS(test_sink(
+            "text/plain; boundary=x"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(test_sink(
+            "multipart/mixed"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(test_sink(
+            "multipart/mixed; boundary=\"x \""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(test_sink(
+            "multipart/mixed; boundary=" +
+                std::string(71, 'x')),
+            std::invalid_argument);
+        BOOST_TEST_NO_THROW(test_sink(
+            "multipart/mixed; boundary=" +
+                std::string(70, 'x')));
+    }
+
+    void
+    run()
+    {
+        testWrite();
+        testParser();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    multipart_sink_test,
+    "boost.http_proto.multipart_sink");
+
+} // http_proto
+} // boost
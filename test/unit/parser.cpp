@@ -20,6 +20,10 @@
 #include <boost/buffers/make_buffer.hpp>
 #include <boost/buffers/string_buffer.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "test_helpers.hpp"
@@ -1399,13 +1403,28 @@ struct parser_test
         core::string_view sh,
         core::string_view sb,
         Fn const& fn)
+    {
+        grind(sh, sb, sb, fn);
+    }
+
+    // sp is the payload, sb is the
+    // expected body after decoding.
+    //
+    // void Fn( pieces& )
+    template<class Fn>
+    void
+    grind(
+        core::string_view sh,
+        core::string_view sp,
+        core::string_view sb,
+        Fn const& fn)
     {
         std::string const s = [&]
         {
             std::string s;
-            s.reserve(sh.size() + sb.size());
+            s.reserve(sh.size() + sp.size());
             s.append(sh.data(), sh.size());
-            s.append(sb.data(), sb.size());
+            s.append(sp.data(), sp.size());
             return s;
         }();
 
@@ -1485,6 +1504,35 @@ struct parser_test
             check_res(sh, sb);
     }
 
+    void
+    should_pass(
+        core::string_view sh,
+        core::string_view sp,
+        core::string_view sb)
+    {
+        BOOST_ASSERT(! sh.empty());
+        if(sh[0] != 'H')
+            pr_ = &req_pr_;
+        else
+            pr_ = &res_pr_;
+        grind(sh, sp, sb, [&](
+            pieces const& in0)
+            {
+                {
+                    auto in = in0;
+                    check_in_place(in);
+                }
+                {
+                    auto in = in0;
+                    check_dynamic(in);
+                }
+                {
+                    auto in = in0;
+                    check_sink(in);
+                }
+            });
+    }
+
     void
     should_fail(
         system::error_code ex,
@@ -1587,6 +1635,403 @@ struct parser_test
             "Hello");
     }
 
+    void
+    testParseChunked()
+    {
+        core::string_view const req =
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n";
+
+        should_pass(req,
+            "0\r\n\r\n",
+            "");
+
+        should_pass(req,
+            "3\r\n123\r\n0\r\n\r\n",
+            "123");
+
+        should_pass(req,
+            "1\r\n1\r\n2\r\n23\r\n0\r\n\r\n",
+            "123");
+
+        should_pass(req,
+            "0003\r\nabc\r\n0\r\n\r\n",
+            "abc");
+
+        // chunk-ext
+        should_pass(req,
+            "1;a=b;c\r\n1\r\n"
+            "2 ; n = \"q\\\"v\" \r\n23\r\n"
+            "0;last\r\n\r\n",
+            "123");
+
+        // trailer-section
+        should_pass(req,
+            "1\r\nx\r\n0\r\n"
+            "Digest: abc\r\n"
+            "X: \r\n"
+            "\r\n",
+            "x");
+
+        should_pass(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            "2\r\nab\r\n0\r\n\r\n",
+            "ab");
+
+        // missing chunk-size
+        should_fail(
+            error::bad_payload, req,
+            "x\r\n0\r\n\r\n");
+
+        // missing CRLF after chunk-data
+        should_fail(
+            error::bad_payload, req,
+            "1\r\n1X0\r\n\r\n");
+
+        // bad chunk-ext
+        should_fail(
+            error::bad_payload, req,
+            "1;=\r\n1\r\n0\r\n\r\n");
+
+        should_fail(
+            error::numeric_overflow, req,
+            "10000000000000000\r\n");
+
+        should_fail(
+            error::body_too_large, req,
+            "6\r\n123456\r\n0\r\n\r\n");
+
+        should_fail(
+            error::body_too_large, req,
+            "3\r\n123\r\n3\r\n456\r\n0\r\n\r\n");
+
+        should_fail(
+            error::incomplete, req,
+            "3\r\n12");
+
+        should_fail(
+            error::incomplete, req,
+            "3\r\n123\r\n0\r\n");
+
+        should_fail(
+            error::bad_field_name, req,
+            "0\r\n:x\r\n\r\n");
+    }
+
+    void
+    testTrailers()
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.body_limit = 1024 * 1024;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        pr.reset();
+
+        // parse a message into `body`,
+        // committing up to 1000 bytes
+        // of input at a time
+        auto const parse = [&pr](
+            core::string_view s,
+            std::string& body)
+        {
+            bool attached = false;
+            system::error_code ec;
+            for(;;)
+            {
+                if(! s.empty())
+                {
+                    auto const n = buffers::buffer_copy(
+                        pr.prepare(),
+                        buffers::const_buffer(
+                            s.data(), (std::min)(
+                                s.size(),
+                                std::size_t(1000))));
+                    pr.commit(n);
+                    s.remove_prefix(n);
+                }
+                pr.parse(ec);
+                if( pr.got_header() &&
+                    ! attached)
+                {
+                    attached = true;
+                    pr.set_body(
+                        buffers::string_buffer(&body));
+                    continue;
+                }
+                if( pr.is_complete() ||
+                    ec != condition::need_more_input ||
+                    s.empty())
+                    return ec;
+            }
+        };
+
+        core::string_view const req =
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n";
+
+        // trailer fields
+        {
+            pr.start();
+            std::string body;
+            auto ec = parse(std::string(req) +
+                "5\r\nhello\r\n"
+                "0\r\n"
+                "Digest: sha-256=abc\r\n"
+                "X-Checksum: 1234\r\n"
+                "\r\n", body);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(body, "hello");
+            auto const t = pr.trailers();
+            BOOST_TEST_EQ(t.size(), 2);
+            BOOST_TEST_EQ(t.value_or(
+                "Digest", ""), "sha-256=abc");
+            BOOST_TEST_EQ(t.value_or(
+                "x-checksum", ""), "1234");
+            BOOST_TEST(! t.exists(
+                field::content_length));
+        }
+
+        // no trailer fields
+        {
+            pr.start();
+            std::string body;
+            auto ec = parse(std::string(req) +
+                "5\r\nhello\r\n"
+                "0\r\n\r\n", body);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.trailers().size(), 0);
+        }
+
+        // not chunked
+        {
+            pr.start();
+            std::string body;
+            auto ec = parse(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "hello", body);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.trailers().size(), 0);
+        }
+
+        // trailers which wrap around
+        // the end of the input buffer
+        for(std::size_t i = 0; i < 64; ++i)
+        {
+            std::string s(req);
+            std::string expected;
+            auto const c = static_cast<
+                char>('a' + i % 26);
+            std::size_t n = 9000 + i;
+            while(n > 0)
+            {
+                auto const m =
+                    (std::min)(n, std::size_t(1000));
+                char hex[8];
+                std::snprintf(hex, sizeof(hex),
+                    "%x\r\n", static_cast<
+                        unsigned>(m));
+                s += hex;
+                s.append(m, c);
+                expected.append(m, c);
+                s += "\r\n";
+                n -= m;
+            }
+            s +=
+                "0\r\n"
+                "Server-Timing: total;dur=123\r\n"
+                "Digest: crc32c=AAAAAA==\r\n"
+                "\r\n";
+            pr.start();
+            std::string body;
+            auto ec = parse(s, body);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(body == expected);
+            auto const t = pr.trailers();
+            BOOST_TEST_EQ(t.size(), 2);
+            BOOST_TEST_EQ(t.value_or(
+                "Server-Timing", ""),
+                "total;dur=123");
+            BOOST_TEST_EQ(t.value_or(
+                "Digest", ""),
+                "crc32c=AAAAAA==");
+        }
+
+        // pipelined
+        {
+            pr.start();
+            std::string body;
+            auto ec = parse(std::string(req) +
+                "0\r\n"
+                "Digest: sha-256=abc\r\n"
+                "\r\n"
+                "GET /2 HTTP/1.1\r\n"
+                "\r\n", body);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.trailers().size(), 1);
+            pr.start();
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.get().target_text(), "/2");
+            BOOST_TEST_EQ(pr.trailers().size(), 0);
+        }
+
+        // message not complete
+        {
+            pr.start();
+            BOOST_TEST_THROWS(pr.trailers(),
+                std::logic_error);
+            pr.reset();
+        }
+    }
+
+    void
+    testPullSome()
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.min_buffer = 3;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        pieces in = {
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "12",
+            "345" };
+        system::error_code ec;
+        pr.reset();
+        pr.start();
+        read_header(pr, in, ec);
+        if(! BOOST_TEST(! ec.failed()))
+            return;
+        std::string body;
+        for(;;)
+        {
+            auto const cb = pr.pull_some();
+            body += test_to_string(cb);
+            if(pr.is_complete())
+                break;
+            read_some(pr, in, ec);
+            if(ec == condition::need_more_input)
+                continue;
+            if(! BOOST_TEST(! ec.failed()))
+                return;
+        }
+        body += test_to_string(pr.pull_some());
+        BOOST_TEST_EQ(body, "12345");
+        BOOST_TEST(buffers::buffer_size(
+            pr.pull_some()) == 0);
+    }
+
+    void
+    testParseDecoded()
+    {
+    #ifdef BOOST_HTTP_PROTO_HAS_ZLIB
+        context ctx;
+        zlib::deflate_decoder_service::config cfg0;
+        cfg0.install(ctx);
+        response_parser::config cfg1;
+        cfg1.apply_deflate_decoder = true;
+        install_parser_service(ctx, cfg1);
+
+        // zlib and gzip wrappings of
+        // "Hello, world!"
+        core::string_view const zs(
+            "\x78\x9c\xf3\x48\xcd\xc9\xc9\xd7"
+            "\x51\x28\xcf\x2f\xca\x49\x51\x04"
+            "\x00\x20\x5e\x04\x8a", 21);
+        core::string_view const gz(
+            "\x1f\x8b\x08\x00\x00\x00\x00\x00"
+            "\x02\x03\xf3\x48\xcd\xc9\xc9\xd7"
+            "\x51\x28\xcf\x2f\xca\x49\x51\x04"
+            "\x00\xe6\xc6\xe6\xeb\x0d\x00\x00"
+            "\x00", 33);
+
+        auto const check = [&](
+            core::string_view sh,
+            core::string_view sp,
+            system::error_code ex = {})
+        {
+            response_parser pr(ctx);
+            std::string s(sh);
+            s.append(sp.data(), sp.size());
+            // one byte at a time
+            pieces in;
+            for(auto const& c : s)
+                in.emplace_back(&c, 1);
+            system::error_code ec;
+            pr.reset();
+            pr.start();
+            read(pr, in, ec);
+            if(ex.failed())
+            {
+                BOOST_TEST_EQ(ec, ex);
+                return;
+            }
+            if(! BOOST_TEST(! ec.failed()))
+                return;
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.body(), "Hello, world!");
+        };
+
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Encoding: deflate\r\n"
+            "Content-Length: 21\r\n"
+            "\r\n", zs);
+
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Length: 33\r\n"
+            "\r\n", gz);
+
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Encoding: gzip\r\n"
+            "\r\n", gz);
+
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: gzip, chunked\r\n"
+            "\r\n",
+            std::string("21\r\n") +
+                std::string(gz) +
+                "\r\n0\r\n\r\n");
+
+        // truncated
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Content-Length: 20\r\n"
+            "\r\n", gz.substr(0, 20),
+            error::incomplete);
+
+        // data past the end of the stream
+        check(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Encoding: deflate\r\n"
+            "Content-Length: 22\r\n"
+            "\r\n", std::string(zs) + "x",
+            error::bad_payload);
+    #endif
+    }
+
     //-------------------------------------------
 
     void
@@ -1609,6 +2054,10 @@ struct parser_test
             testParseHeader();
             testParseRequest();
             testParseResponse();
+            testParseChunked();
+            testTrailers();
+            testPullSome();
+            testParseDecoded();
         }
     }
 };
@@ -13,9 +13,11 @@
 
 #include <boost/http_proto/request_view.hpp>
 
+#include <string>
 #include <utility>
 
 #include "boost/http_proto/message_base.hpp"
+#include "test_helpers.hpp"
 #include "test_suite.hpp"
 
 namespace boost {
@@ -805,6 +807,168 @@ struct request_test
         }
     }
 
+    void
+    testResource()
+    {
+        test_resource mr;
+        {
+            request req(mr);
+            BOOST_TEST(req.resource() == &mr);
+            BOOST_TEST_EQ(mr.allocs, 0U);
+            req.set_method(method::get);
+            req.set_target("/index.htm");
+            req.set(field::host, "example.com");
+            BOOST_TEST_EQ(req.buffer(),
+                "GET /index.htm HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                mr.bytes, req.capacity_in_bytes());
+
+            request m2(std::move(req));
+            BOOST_TEST(m2.resource() == &mr);
+            BOOST_TEST(req.resource() == &mr);
+
+            request m3(m2);
+            BOOST_TEST(m3.resource() == nullptr);
+            BOOST_TEST_EQ(m3.buffer(), m2.buffer());
+        }
+        BOOST_TEST_EQ(mr.bytes, 0U);
+    }
+
+    void
+    testAppendList()
+    {
+        // metadata is updated
+        request req;
+        req.set_method(method::post);
+        req.set_target("/");
+        BOOST_TEST(! req.append({
+            { field::host, "example.com" },
+            { field::content_length, "42" },
+            { field::connection, "close" } }
+                ).has_error());
+        BOOST_TEST_EQ(req.buffer(),
+            "POST / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Content-Length: 42\r\n"
+            "Connection: close\r\n"
+            "\r\n");
+        BOOST_TEST(req.payload() == payload::size);
+        BOOST_TEST_EQ(req.payload_size(), 42U);
+        BOOST_TEST(! req.keep_alive());
+    }
+
+    void
+    testTargetUrl()
+    {
+        // default target
+        {
+            request req;
+            auto rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(rv->buffer(), "/");
+        }
+
+        // the target changes in place
+        {
+            request req;
+            req.set_target("/a?x=1");
+            auto rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->path(), "/a");
+                BOOST_TEST_EQ(rv->query(), "x=1");
+            }
+            BOOST_TEST(request_view(req).target_url()
+                ->buffer().data() == rv->buffer().data());
+            req.set_target("/b?y=2");
+            rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->path(), "/b");
+                BOOST_TEST_EQ(rv->query(), "y=2");
+            }
+        }
+
+        // the buffer moves
+        {
+            request req;
+            req.set_target("/a%20b");
+            BOOST_TEST_EQ(
+                req.target_url()->path(), "/a b");
+            req.set(field::host, std::string(500, 'x'));
+            auto rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST(rv->buffer().data() ==
+                    req.target().data());
+        }
+
+        // assignment
+        {
+            request r0;
+            r0.set_target("/x");
+            request r1;
+            r1.set_target("/y");
+            BOOST_TEST_EQ(r1.target_url()->path(), "/y");
+            r1 = r0;
+            BOOST_TEST_EQ(r1.target_url()->path(), "/x");
+            swap(r0, r1);
+            BOOST_TEST_EQ(r0.target_url()->path(), "/x");
+            BOOST_TEST_EQ(r1.target_url()->path(), "/x");
+        }
+
+        // the target changes in place
+        // while the buffers are swapped
+        {
+            request a;
+            a.set_target("/a");
+            request b;
+            b.set_target("/b");
+            BOOST_TEST_EQ(a.target_url()->path(), "/a");
+            swap(a, b);
+            b.set_target("/c");
+            swap(a, b);
+            BOOST_TEST_EQ(a.target_url()->path(), "/c");
+            BOOST_TEST_EQ(b.target_url()->path(), "/b");
+        }
+
+        // move
+        {
+            request a;
+            a.set_target("/a");
+            BOOST_TEST_EQ(a.target_url()->path(), "/a");
+            request b(std::move(a));
+            b.set_target("/b");
+            a = std::move(b);
+            BOOST_TEST_EQ(a.target_url()->path(), "/b");
+        }
+
+        // absolute-form
+        {
+            request req;
+            req.set_target("http://example.com/index.html");
+            auto rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->host(), "example.com");
+                BOOST_TEST_EQ(rv->path(), "/index.html");
+            }
+        }
+
+        // errors
+        {
+            request req;
+            req.set_target("*");
+            BOOST_TEST(req.target_url().has_error());
+            BOOST_TEST(req.target_url().has_error());
+            req.set_target("/%zz");
+            BOOST_TEST(req.target_url().has_error());
+            req.set_target("/");
+            BOOST_TEST(req.target_url().has_value());
+        }
+    }
+
     void
     run()
     {
@@ -815,6 +979,9 @@ struct request_test
         testModifiers();
         testExpect();
         testInitialSize();
+        testResource();
+        testAppendList();
+        testTargetUrl();
     }
 };
 
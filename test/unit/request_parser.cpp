@@ -11,6 +11,7 @@
 #include <boost/http_proto/request_parser.hpp>
 
 #include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request.hpp>
 #include <boost/http_proto/rfc/combine_field_values.hpp>
 
 #include "boost/http_proto/parser.hpp"
@@ -19,6 +20,7 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace boost {
 namespace http_proto {
@@ -286,6 +288,18 @@ struct request_parser_test
         good(ctx, f("x: abc\r\n def"),
                   f("x: abc   def"));
 
+        // wide enough for the vector scanners
+        good(ctx, f("x-0123456789-abcdefghijklmnopqrstuvwxyz: y"));
+        good(ctx, f("x: 0123456789 abcdefghijklmnopqrstuvwxyz\t!~"));
+        good(ctx, f("x: 0123456789abcdefghijklmnopqrstuvwxyz\x80\xff"));
+        good(ctx, f("x: 0123456789abcdefghijklmnopqrstuvwxyz \r\n y"),
+                  f("x: 0123456789abcdefghijklmnopqrstuvwxyz    y"));
+        bad(ctx, f("x-0123456789-abcdefghijklmnopqrstuvwxyz@: y"));
+        bad(ctx, f("x-0123456789-abcdefghijklmnopqrstuvwxyz : y"));
+        bad(ctx, f("x: 0123456789abcdefghijklmnopqrstuvwxyz\x7f"));
+        bad(ctx, f("x: 0123456789abcdefghijklmnopqrstuvwxyz\x01"));
+        bad(ctx, f("x: 0123456789abcdefghijklmnopqrstuvwxyz\ra"));
+
         // errata eid4189
         good(ctx, f("x: , , ,"));
         good(ctx, f("x: abrowser/0.001 (C O M M E N T)"));
@@ -322,6 +336,7 @@ struct request_parser_test
         BOOST_TEST(rv.target_text() == "/");
         BOOST_TEST(rv.version() ==
             version::http_1_1);
+        BOOST_TEST(rv.target_url()->path() == "/");
 
         BOOST_TEST(rv.buffer() == s);
         BOOST_TEST(rv.size() == 7);
@@ -351,6 +366,172 @@ struct request_parser_test
             "a"), temp) == "1,3");
     }
 
+    void
+    testLazyFields()
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.lazy_fields = true;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        core::string_view s =
+            "POST /upload HTTP/1.1\r\n"
+            "User-Agent: x\r\n"
+            "host: example.com\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "a: 1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Accept: *\r\n"
+            "\r\n";
+
+        auto const parse = [&]
+        {
+            pr.reset();
+            pr.start();
+            feed(pr, s);
+            return pr.get();
+        };
+
+        // fields which affect the payload
+        {
+            auto const rv = parse();
+            BOOST_TEST(rv.buffer() == s);
+            BOOST_TEST(rv.size() == 6);
+            BOOST_TEST(rv.chunked());
+            BOOST_TEST(rv.payload() == payload::chunked);
+            BOOST_TEST(rv.metadata().transfer_encoding
+                .encoding == encoding::gzip);
+            BOOST_TEST(rv.count(
+                field::transfer_encoding) == 2);
+            BOOST_TEST_EQ(rv.value_or(
+                field::host, ""), "example.com");
+            BOOST_TEST(
+                rv.find("a")->value == "1");
+            BOOST_TEST(rv.exists(field::accept));
+        }
+
+        // iteration looks up the other names
+        {
+            auto const rv = parse();
+            std::vector<field> ids;
+            for(auto const& f : rv)
+                ids.push_back(f.id);
+            BOOST_TEST((ids == std::vector<field>{
+                field::user_agent,
+                field::host,
+                field::transfer_encoding,
+                field::unknown,
+                field::transfer_encoding,
+                field::accept }));
+            BOOST_TEST_EQ(rv.value_or(
+                field::user_agent, ""), "x");
+        }
+
+        // copies look up the other names
+        {
+            request req(parse());
+            BOOST_TEST(req.buffer() == s);
+            BOOST_TEST(req.exists(field::user_agent));
+            BOOST_TEST(req.count(field::accept) == 1);
+            BOOST_TEST(req.begin()->id ==
+                field::user_agent);
+        }
+    }
+
+    void
+    testPipelined()
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.min_buffer = 256;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+
+        std::string batch;
+        std::vector<std::string> targets;
+        std::vector<std::string> bodies;
+        for(int i = 0; i < 5; ++i)
+        {
+            auto const t =
+                "/" + std::to_string(i);
+            targets.push_back(t);
+            bodies.push_back("");
+            batch +=
+                "GET " + t + " HTTP/1.1\r\n"
+                "Host: x\r\n"
+                "\r\n";
+        }
+        targets.push_back("/post");
+        bodies.push_back("hello");
+        batch +=
+            "POST /post HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+        targets.push_back("/chunked");
+        bodies.push_back("abc");
+        batch +=
+            "POST /chunked HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "3\r\nabc\r\n0\r\n\r\n";
+        targets.push_back("/last");
+        bodies.push_back("");
+        batch +=
+            "GET /last HTTP/1.1\r\n"
+            "\r\n";
+
+        pr.reset();
+        pr.start();
+
+        // the whole batch in each commit, split
+        // at every possible point in between
+        for(std::size_t split = 0;
+            split <= batch.size(); ++split)
+        {
+            std::size_t i = 0;
+            auto const handler =
+                [&](request_view const& req,
+                    core::string_view body)
+                {
+                    if(! BOOST_TEST(
+                            i < targets.size()))
+                        return;
+                    BOOST_TEST_EQ(
+                        req.target_text(),
+                        targets[i]);
+                    BOOST_TEST_EQ(
+                        req.target_url()->path(),
+                        targets[i]);
+                    BOOST_TEST_EQ(body, bodies[i]);
+                    ++i;
+                };
+            core::string_view s[2] = {
+                core::string_view(batch).substr(
+                    0, split),
+                core::string_view(batch).substr(
+                    split) };
+            for(auto part : s)
+            {
+                while(! part.empty())
+                {
+                    auto const b =
+                        *pr.prepare().begin();
+                    auto const n = (std::min)(
+                        b.size(), part.size());
+                    std::memcpy(b.data(),
+                        part.data(), n);
+                    pr.commit(n);
+                    part.remove_prefix(n);
+                    system::error_code ec;
+                    pr.parse_batch(handler, ec);
+                    BOOST_TEST(! ec.failed());
+                }
+            }
+            BOOST_TEST_EQ(i, targets.size());
+        }
+    }
+
     void
     run()
     {
@@ -358,6 +539,8 @@ struct request_parser_test
         testParse();
         testParseField();
         testGet();
+        testLazyFields();
+        testPipelined();
     }
 };
 
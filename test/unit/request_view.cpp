@@ -42,6 +42,14 @@ public:
                 req1 = req2;
             }
         }
+
+        // target_url()
+        {
+            request_view req;
+            auto rv = req.target_url();
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(rv->path(), "/");
+        }
     }
 };
 
@@ -16,6 +16,7 @@
 
 #include <boost/core/detail/string_view.hpp>
 
+#include "test_helpers.hpp"
 #include "test_suite.hpp"
 
 namespace boost {
@@ -452,12 +453,41 @@ public:
         }
     }
 
+    void
+    testResource()
+    {
+        test_resource mr;
+        {
+            response res(mr);
+            BOOST_TEST(res.resource() == &mr);
+            BOOST_TEST_EQ(mr.allocs, 0U);
+            res.set_start_line(status::not_found);
+            res.set(field::server, "boost");
+            BOOST_TEST_EQ(res.buffer(),
+                "HTTP/1.1 404 Not Found\r\n"
+                "Server: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                mr.bytes, res.capacity_in_bytes());
+
+            response m2(std::move(res));
+            BOOST_TEST(m2.resource() == &mr);
+            BOOST_TEST(res.resource() == &mr);
+
+            response m3(m2);
+            BOOST_TEST(m3.resource() == nullptr);
+            BOOST_TEST_EQ(m3.buffer(), m2.buffer());
+        }
+        BOOST_TEST_EQ(mr.bytes, 0U);
+    }
+
     void
     run()
     {
         testSpecial();
         testModifiers();
         testInitialSize();
+        testResource();
     }
 };
 
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/response_template.hpp>
+
+#include <boost/http_proto/serializer.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct response_template_test
+{
+    static
+    std::string
+    read(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto const cbs = sr.prepare().value();
+            auto const n = buffers::buffer_size(cbs);
+            auto const n0 = s.size();
+            s.resize(n0 + n);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &s[n0], n), cbs);
+            sr.consume(n);
+        }
+        return s;
+    }
+
+    void
+    testTemplate()
+    {
+        response res(status::ok);
+        res.set(field::server, "test");
+        res.set(field::content_length, "5");
+        res.set(field::content_type, "text/plain");
+
+        // slot fields move to the end
+        response_template tpl(res);
+        BOOST_TEST_EQ(tpl.buffer(),
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 5                   \r\n"
+            "Date:                              \r\n"
+            "\r\n");
+        {
+            response_view rv = tpl;
+            BOOST_TEST_EQ(rv.size(), 4u);
+            BOOST_TEST_EQ(rv.value_or(
+                field::content_length, "x"), "5");
+            BOOST_TEST_EQ(rv.value_or(
+                field::date, "x"), "");
+            BOOST_TEST_EQ(rv.payload(), payload::size);
+            BOOST_TEST_EQ(rv.payload_size(), 5u);
+        }
+
+        auto const size = tpl.buffer().size();
+        tpl.set_content_length(123456);
+        tpl.set(field::date,
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BOOST_TEST_EQ(tpl.buffer().size(), size);
+        BOOST_TEST_EQ(tpl.buffer(),
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 123456              \r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "\r\n");
+        {
+            response_view rv = tpl;
+            BOOST_TEST_EQ(rv.value_or(
+                field::content_length, "x"), "123456");
+            BOOST_TEST_EQ(rv.value_or(
+                field::date, "x"),
+                "Sun, 06 Nov 1994 08:49:37 GMT");
+            BOOST_TEST_EQ(rv.payload_size(), 123456u);
+        }
+
+        // copies are independent
+        response_template tpl2(tpl);
+        tpl2.set(field::date, "x");
+        BOOST_TEST_EQ(response_view(tpl).value_or(
+            field::date, ""),
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BOOST_TEST_EQ(response_view(tpl2).value_or(
+            field::date, ""), "x");
+
+        // widest value
+        tpl.set_content_length(UINT64_MAX);
+        BOOST_TEST_EQ(response_view(tpl).value_or(
+            field::content_length, ""),
+            "18446744073709551615");
+    }
+
+    void
+    testSlots()
+    {
+        response res(status::not_found);
+        res.set(field::etag, "\"a\"");
+        response_template tpl(res, {
+            { field::etag, 8 },
+            { field::cache_control, 16 } });
+        BOOST_TEST_EQ(tpl.buffer(),
+            "HTTP/1.1 404 Not Found\r\n"
+            "ETag: \"a\"     \r\n"
+            "Cache-Control:                 \r\n"
+            "\r\n");
+        tpl.set(field::cache_control, "max-age=60");
+        tpl.set(field::etag, "");
+        BOOST_TEST_EQ(tpl.buffer(),
+            "HTTP/1.1 404 Not Found\r\n"
+            "ETag:         \r\n"
+            "Cache-Control: max-age=60      \r\n"
+            "\r\n");
+
+        // no slot
+        BOOST_TEST_THROWS(tpl.set(
+            field::date, "x"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            tpl.set_content_length(0),
+            std::invalid_argument);
+
+        // too wide
+        BOOST_TEST_THROWS(tpl.set(
+            field::etag, "\"abcdefg\""),
+            std::length_error);
+
+        // not a field value
+        BOOST_TEST_THROWS(tpl.set(
+            field::etag, "a\r\nX: y"),
+            std::invalid_argument);
+
+        // bad slots
+        BOOST_TEST_THROWS(response_template(res, {
+            { field::unknown, 8 } }),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(response_template(res, {
+            { field::date, 8 }, { field::date, 8 } }),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(response_template(res, {
+            { field::etag, 2 } }),
+            std::length_error);
+
+        // fields tracked by the metadata
+        BOOST_TEST_THROWS(response_template(res, {
+            { field::connection, 16 } }),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(response_template(res, {
+            { field::transfer_encoding, 16 } }),
+            std::invalid_argument);
+    }
+
+    void
+    testPayload()
+    {
+        // no Content-Length in the response
+        response res(status::ok);
+        response_template tpl(res);
+        BOOST_TEST_EQ(response_view(tpl).payload(),
+            payload::none);
+
+        tpl.set_content_length(42);
+        {
+            response_view rv = tpl;
+            BOOST_TEST_EQ(rv.payload(), payload::size);
+            BOOST_TEST_EQ(rv.payload_size(), 42u);
+        }
+
+        tpl.set_content_length(0);
+        {
+            response_view rv = tpl;
+            BOOST_TEST_EQ(rv.payload(), payload::none);
+            BOOST_TEST_EQ(rv.payload_size(), 0u);
+        }
+
+        // chunked responses have no
+        // Content-Length slot
+        res.set_chunked(true);
+        response_template tpl2(res);
+        BOOST_TEST_EQ(tpl2.buffer(),
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Date:                              \r\n"
+            "\r\n");
+        BOOST_TEST_EQ(response_view(tpl2).payload(),
+            payload::chunked);
+        BOOST_TEST_THROWS(
+            tpl2.set_content_length(1),
+            std::invalid_argument);
+    }
+
+    void
+    testSerialize()
+    {
+        response res(status::ok);
+        res.set(field::server, "test");
+        response_template tpl(res);
+
+        std::string const body = "Hello, world!";
+        serializer sr(1024);
+        for(int i = 0; i < 3; ++i)
+        {
+            auto const n = body.size() - i;
+            tpl.set_content_length(n);
+            tpl.set(field::date, "today");
+            sr.start(tpl, buffers::const_buffer(
+                body.data(), n));
+            BOOST_TEST_EQ(read(sr),
+                std::string(tpl.buffer()) +
+                body.substr(0, n));
+            sr.reset();
+        }
+    }
+
+    void
+    run()
+    {
+        testTemplate();
+        testSlots();
+        testPayload();
+        testSerialize();
+    }
+};
+
+TEST_SUITE(
+    response_template_test,
+    "boost.http_proto.response_template");
+
+} // http_proto
+} // boost
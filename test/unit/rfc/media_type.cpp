@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/media_type.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct media_type_test
+{
+    void
+    run()
+    {
+        auto const& t = media_type_rule;
+
+        bad(t, "");
+        bad(t, "text");
+        bad(t, "text/");
+        bad(t, "/plain");
+        bad(t, "text /plain");
+        bad(t, "text/plain;");
+        bad(t, "text/plain; charset");
+        bad(t, "text/plain; charset =utf-8");
+        ok(t,  "text/plain");
+        ok(t,  "text/plain;charset=utf-8");
+        ok(t,  "text/plain ; charset=utf-8");
+        ok(t,  "text/plain;charset=\"utf-8\";format=flowed");
+
+        {
+            auto rv = grammar::parse(
+                "multipart/form-data; "
+                "charset=utf-8; "
+                "boundary=\"--a b\"", t);
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->mime.type, "multipart");
+                BOOST_TEST_EQ(rv->mime.subtype, "form-data");
+                BOOST_TEST_EQ(rv->params.size(), 2u);
+                auto it = rv->params.begin();
+                BOOST_TEST_EQ((*it).name, "charset");
+                BOOST_TEST_EQ((*it).value, "utf-8");
+                ++it;
+                BOOST_TEST_EQ((*it).name, "boundary");
+                BOOST_TEST_EQ((*it).value, "\"--a b\"");
+            }
+        }
+    }
+};
+
+TEST_SUITE(
+    media_type_test,
+    "boost.http_proto.media_type");
+
+} // http_proto
+} // boost
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/rfc/parameter.hpp>
 
+#include <boost/url/grammar/parse.hpp>
+
 #include "test_helpers.hpp"
 
 namespace boost {
@@ -20,6 +22,33 @@ struct parameter_test
     void
     run()
     {
+        auto const& t = parameter_rule;
+
+        bad(t, "");
+        bad(t, "=");
+        bad(t, "x");
+        bad(t, "x=");
+        bad(t, "=y");
+        bad(t, "x =y");
+        bad(t, "x= y");
+        bad(t, "x=\"y");
+        ok(t,  "x=y");
+        ok(t,  "charset=utf-8");
+        ok(t,  "x=\"\"");
+        ok(t,  "x=\"a b\"");
+        ok(t,  "x=\"a\\\"b\"");
+
+        {
+            auto rv = grammar::parse(
+                "boundary=\"a b\"", t);
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(rv->name, "boundary");
+                BOOST_TEST_EQ(rv->value, "\"a b\"");
+                BOOST_TEST_EQ(
+                    rv->value.unescaped_size(), 3u);
+            }
+        }
     }
 };
 
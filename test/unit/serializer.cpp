@@ -11,17 +11,24 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/serializer.hpp>
 
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/mmap_body.hpp>
 #include <boost/http_proto/response.hpp>
 #include <boost/http_proto/string_body.hpp>
+#include <boost/http_proto/service/brotli_service.hpp>
+#include <boost/http_proto/service/zlib_service.hpp>
 #include <boost/buffers/buffer_copy.hpp>
 #include <boost/buffers/buffer_size.hpp>
 #include <boost/buffers/const_buffer.hpp>
 #include <boost/buffers/make_buffer.hpp>
 #include <boost/buffers/mutable_buffer.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <boost/filesystem/operations.hpp>
 #include "test_helpers.hpp"
 
 #include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -30,6 +37,10 @@
 #include <zlib.h>
 #endif
 
+#ifdef BOOST_HTTP_PROTO_HAS_BROTLI
+#include <brotli/decode.h>
+#endif
+
 namespace boost {
 namespace http_proto {
 
@@ -121,6 +132,17 @@ struct serializer_test
         return t;
     }
 
+    // number of hex digits in a chunk size
+    static
+    std::size_t
+    hex_digits(std::size_t n) noexcept
+    {
+        std::size_t d = 1;
+        while(n >>= 4)
+            ++d;
+        return d;
+    }
+
     static
     void
     check_chunked_body(
@@ -292,7 +314,8 @@ struct serializer_test
             BOOST_TEST(!stream.is_full());
             auto mbs = stream.prepare();
 
-            auto bs = buffers::buffer_size(mbs);
+            auto const avail = buffers::buffer_size(mbs);
+            auto bs = avail;
             BOOST_TEST_GT(bs, 0);
 
             if( bs > body.size() )
@@ -311,8 +334,10 @@ struct serializer_test
             if(! res.chunked() )
                 BOOST_TEST_EQ(stream.size(), bs);
             else
-                // chunk overhead: header + \r\n
-                BOOST_TEST_EQ(stream.size(), bs + 18 + 2);
+                // chunk overhead: header + \r\n, where
+                // the header fits the largest chunk
+                BOOST_TEST_EQ(stream.size(), bs +
+                    hex_digits(avail) + 2 + 2);
 
             check_N();
         };
@@ -413,7 +438,7 @@ struct serializer_test
             "Server: test\r\n"
             "Transfer-Encoding: chunked\r\n"
             "\r\n"
-            "0000000000000005\r\n"
+            "5\r\n"
             "12345"
             "\r\n"
             "0\r\n"
@@ -781,6 +806,746 @@ struct serializer_test
         }
     }
 
+    void
+    testStreamCoalesce()
+    {
+        // writes all the pending output,
+        // counting the calls which send any
+        auto const drain = [](
+            serializer& sr,
+            std::string& s,
+            std::size_t& writes)
+        {
+            while(! sr.is_done())
+            {
+                auto rv = sr.prepare();
+                if(! rv)
+                {
+                    BOOST_TEST(
+                        rv.error() == error::need_data);
+                    return;
+                }
+                auto const n = buffers::buffer_size(*rv);
+                auto const n0 = s.size();
+                s.resize(n0 + n);
+                buffers::buffer_copy(
+                    buffers::mutable_buffer(
+                        &s[n0], n), *rv);
+                sr.consume(n);
+                ++writes;
+            }
+        };
+
+        auto const write = [](
+            serializer::stream& st,
+            core::string_view s)
+        {
+            auto const n = buffers::buffer_copy(
+                st.prepare(),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST_EQ(n, s.size());
+            st.commit(n);
+        };
+
+        // chunked
+        {
+            core::string_view sv =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 100);
+            std::string s;
+            std::size_t writes = 0;
+            for(int i = 0; i < 50; ++i)
+            {
+                write(st, "0123456789");
+                drain(sr, s, writes);
+            }
+            BOOST_TEST_EQ(writes, 5);
+
+            // nothing pending
+            st.flush();
+            drain(sr, s, writes);
+            BOOST_TEST_EQ(writes, 5);
+
+            write(st, "abcde");
+            drain(sr, s, writes);
+            BOOST_TEST_EQ(writes, 5);
+            st.flush();
+            drain(sr, s, writes);
+            BOOST_TEST_EQ(writes, 6);
+
+            st.close();
+            drain(sr, s, writes);
+            BOOST_TEST_EQ(writes, 7);
+            BOOST_TEST(sr.is_done());
+
+            std::string expected = sv;
+            for(int i = 0; i < 5; ++i)
+            {
+                expected += "64\r\n";
+                for(int j = 0; j < 10; ++j)
+                    expected += "0123456789";
+                expected += "\r\n";
+            }
+            expected += "5\r\nabcde\r\n0\r\n\r\n";
+            BOOST_TEST_EQ(s, expected);
+        }
+
+        // chunked, larger than the buffer
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 4096);
+            std::string body;
+            for(int i = 0; i < 300; ++i)
+                body += "0123456789";
+            std::string s;
+            std::size_t writes = 0;
+            core::string_view rest = body;
+            while(! rest.empty())
+            {
+                if(st.is_full())
+                {
+                    drain(sr, s, writes);
+                    continue;
+                }
+                auto const n = buffers::buffer_copy(
+                    st.prepare(),
+                    buffers::const_buffer(
+                        rest.data(), rest.size()));
+                st.commit(n);
+                rest.remove_prefix(n);
+            }
+            st.close();
+            drain(sr, s, writes);
+            BOOST_TEST(sr.is_done());
+            core::string_view sv = s;
+            sv.remove_prefix(res.buffer().size());
+            check_chunked_body(sv, body);
+        }
+
+        // Content-Length
+        {
+            core::string_view sv =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 50\r\n"
+                "\r\n";
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 20);
+            std::string s;
+            std::size_t writes = 0;
+            for(int i = 0; i < 9; ++i)
+            {
+                write(st, "01234");
+                drain(sr, s, writes);
+            }
+            BOOST_TEST_EQ(writes, 2);
+            write(st, "01234");
+            st.close();
+            drain(sr, s, writes);
+            BOOST_TEST_EQ(writes, 3);
+            BOOST_TEST(sr.is_done());
+            BOOST_TEST_EQ(s, std::string(sv) +
+                "01234012340123401234012340"
+                "123401234012340123401234");
+        }
+    }
+
+    void
+    testStreamTrailers()
+    {
+        core::string_view const sv =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n";
+
+        fields tr;
+        tr.append("Digest", "sha-256=abc");
+        tr.append("X-Long", std::string(300, 'x'));
+        std::string const last =
+            "0\r\n"
+            "Digest: sha-256=abc\r\n"
+            "X-Long: " + std::string(300, 'x') + "\r\n"
+            "\r\n";
+
+        auto const write = [](
+            serializer::stream& st,
+            core::string_view s)
+        {
+            auto const n = buffers::buffer_copy(
+                st.prepare(),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST_EQ(n, s.size());
+            st.commit(n);
+        };
+
+        // chunks written in place
+        {
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res);
+            write(st, "hello");
+            st.close(tr);
+            auto const s = read(sr);
+            BOOST_TEST(core::string_view(s).ends_with(
+                "hello\r\n" + last));
+        }
+
+        // gathered chunks
+        {
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 100);
+            write(st, "hello");
+            st.close(tr);
+            BOOST_TEST_EQ(read(sr), std::string(sv) +
+                "5\r\nhello\r\n" + last);
+        }
+
+        // no trailers
+        {
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 100);
+            write(st, "hello");
+            st.close(fields());
+            BOOST_TEST_EQ(read(sr), std::string(sv) +
+                "5\r\nhello\r\n0\r\n\r\n");
+        }
+
+        // not chunked
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            serializer sr(1024);
+            auto st = sr.start_stream(res);
+            write(st, "hello");
+            BOOST_TEST_THROWS(st.close(tr),
+                std::logic_error);
+            st.close();
+            BOOST_TEST_EQ(read(sr),
+                std::string(res.buffer()) + "hello");
+        }
+
+        // forbidden trailers
+        {
+            response res(sv);
+            serializer sr(1024);
+            auto st = sr.start_stream(res, 100);
+            write(st, "hello");
+            fields bad0;
+            bad0.append(field::content_length, "5");
+            BOOST_TEST_THROWS(st.close(bad0),
+                std::invalid_argument);
+            fields bad1;
+            bad1.append("host", "example.com");
+            BOOST_TEST_THROWS(st.close(bad1),
+                std::invalid_argument);
+            st.close();
+            BOOST_TEST_EQ(read(sr), std::string(sv) +
+                "5\r\nhello\r\n0\r\n\r\n");
+        }
+    }
+
+#ifdef BOOST_HTTP_PROTO_HAS_ZLIB
+    static
+    std::string
+    inflate_all(core::string_view s)
+    {
+        std::string rv;
+        z_stream zs{};
+        // detect zlib or gzip
+        if(! BOOST_TEST_EQ(
+            inflateInit2(&zs, 15 + 32), Z_OK))
+            return rv;
+        zs.next_in = reinterpret_cast<Bytef*>(
+            const_cast<char*>(s.data()));
+        zs.avail_in = static_cast<uInt>(s.size());
+        int ret;
+        do
+        {
+            char buf[1024];
+            zs.next_out =
+                reinterpret_cast<Bytef*>(buf);
+            zs.avail_out = sizeof(buf);
+            ret = inflate(&zs, Z_NO_FLUSH);
+            rv.append(buf,
+                sizeof(buf) - zs.avail_out);
+        }
+        while(ret == Z_OK);
+        BOOST_TEST_EQ(ret, Z_STREAM_END);
+        BOOST_TEST_EQ(zs.avail_in, 0u);
+        inflateEnd(&zs);
+        return rv;
+    }
+
+    static
+    std::string
+    dechunk(core::string_view s)
+    {
+        std::string rv;
+        for(;;)
+        {
+            auto const pos = s.find("\r\n");
+            if(! BOOST_TEST(
+                    pos != core::string_view::npos))
+                return rv;
+            auto const n = std::stoul(
+                std::string(s.data(), pos),
+                nullptr, 16);
+            s.remove_prefix(pos + 2);
+            if(n == 0)
+            {
+                BOOST_TEST_EQ(s, "\r\n");
+                return rv;
+            }
+            // chunks are never empty
+            BOOST_TEST_GT(n, 0u);
+            rv.append(s.data(), n);
+            s.remove_prefix(n);
+            BOOST_TEST_EQ(s.substr(0, 2), "\r\n");
+            s.remove_prefix(2);
+        }
+    }
+
+    void
+    testEncoding()
+    {
+        context ctx;
+        zlib::deflate_encoder_service::config cfg;
+        cfg.install(ctx);
+
+        std::string body;
+        for(int i = 0; i < 2000; ++i)
+            body += std::to_string(i * 7919 % 1009) + ' ';
+
+        auto const check = [&](
+            core::string_view headers,
+            bool chunked,
+            std::size_t buffer_size,
+            bool stream)
+        {
+            response res(headers);
+            serializer sr(ctx, buffer_size);
+            std::string s;
+            if(! stream)
+            {
+                sr.start<test_source>(res, body);
+                s = read(sr);
+            }
+            else
+            {
+                auto st = sr.start_stream(res);
+                std::size_t i = 0;
+                if(body.empty())
+                    st.close();
+                while(! sr.is_done())
+                {
+                    if(i < body.size())
+                    {
+                        auto const n =
+                            buffers::buffer_copy(
+                                st.prepare(),
+                                buffers::const_buffer(
+                                    body.data() + i,
+                                    body.size() - i));
+                        st.commit(n);
+                        i += n;
+                        if(i == body.size())
+                            st.close();
+                    }
+                    auto rv = sr.prepare();
+                    if(rv.has_error())
+                    {
+                        BOOST_TEST(
+                            rv.error() == error::need_data);
+                        continue;
+                    }
+                    auto const n = append(s, *rv);
+                    sr.consume(n);
+                }
+            }
+            if(! BOOST_TEST(
+                s.substr(0, headers.size()) == headers))
+                return;
+            core::string_view sv(s);
+            sv.remove_prefix(headers.size());
+            std::string encoded;
+            if(chunked)
+                encoded = dechunk(sv);
+            else
+                encoded.assign(
+                    sv.data(), sv.size());
+            BOOST_TEST_LT(
+                encoded.size(), body.size());
+            BOOST_TEST(inflate_all(encoded) == body);
+        };
+
+        for(bool stream : { false, true })
+        for(std::size_t n : { 256, 65536 })
+        {
+            check(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Encoding: gzip\r\n"
+                "\r\n", false, n, stream);
+
+            check(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Encoding: deflate\r\n"
+                "\r\n", false, n, stream);
+
+            check(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Encoding: gzip\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n", true, n, stream);
+
+            check(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: deflate, chunked\r\n"
+                "\r\n", true, n, stream);
+        }
+
+        // the identity coding is not encoded
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start<test_source>(res, "12345");
+            BOOST_TEST_EQ(read(sr),
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "12345");
+        }
+    }
+#endif
+
+#ifdef BOOST_HTTP_PROTO_HAS_BROTLI
+    void
+    testBrotli()
+    {
+        // more than the fast qualities
+        // take in one call, in windows
+        // smaller than the body
+        std::string body;
+        for(int i = 0; body.size() < 200000; ++i)
+            body += std::to_string(i * 7919 % 100003) + ' ';
+
+        auto const check = [&](
+            unsigned quality,
+            unsigned window_bits)
+        {
+            context ctx;
+            brotli::encoder_service::config cfg;
+            cfg.quality = quality;
+            cfg.window_bits = window_bits;
+            cfg.install(ctx);
+
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Encoding: br\r\n"
+                "\r\n");
+            serializer sr(ctx, 65536);
+            sr.start<test_source>(res, body);
+            auto const s = read(sr);
+            core::string_view sv(s);
+            sv.remove_prefix(res.buffer().size());
+            BOOST_TEST_LT(sv.size(), body.size());
+
+            std::string decoded(body.size(), '\0');
+            std::size_t n = decoded.size();
+            BOOST_TEST(BrotliDecoderDecompress(
+                sv.size(),
+                reinterpret_cast<
+                    std::uint8_t const*>(sv.data()),
+                &n,
+                reinterpret_cast<
+                    std::uint8_t*>(&decoded[0])) ==
+                BROTLI_DECODER_RESULT_SUCCESS);
+            decoded.resize(n);
+            BOOST_TEST(decoded == body);
+        };
+
+        for(unsigned q : { 0u, 1u, 5u })
+        for(unsigned w : { 10u, 16u, 18u })
+            check(q, w);
+    }
+#endif
+
+    //--------------------------------------------
+
+    // Send the body the way sendfile
+    // would, from a second handle
+    static
+    std::string
+    read_file(serializer& sr, char const* path)
+    {
+        std::string s;
+        file f;
+        system::error_code ec;
+        f.open(path, file_mode::read, ec);
+        BOOST_TEST(! ec.failed());
+        while(! sr.is_done())
+        {
+            auto rv = sr.prepare();
+            if(rv.has_value())
+            {
+                auto const n = append(s, *rv);
+                sr.consume(n);
+                continue;
+            }
+            BOOST_TEST(rv.error() == error::need_file);
+            auto const fr = sr.file_data();
+            BOOST_TEST_GT(fr.size, 0u);
+            char buf[7];
+            auto n = (std::min)(
+                sizeof(buf), static_cast<
+                    std::size_t>(fr.size));
+            f.seek(fr.offset, ec);
+            BOOST_TEST(! ec.failed());
+            n = f.read(buf, n, ec);
+            BOOST_TEST(! ec.failed());
+            s.append(buf, n);
+            sr.consume_file(n);
+        }
+        return s;
+    }
+
+    void
+    testFile()
+    {
+        auto const path =
+            boost::filesystem::unique_path();
+        std::string const body =
+            "0123456789abcdefghijklmnopqrstuvwxyz";
+        {
+            file f;
+            system::error_code ec;
+            f.open(path.string().c_str(),
+                file_mode::write, ec);
+            BOOST_TEST(! ec.failed());
+            f.write(body.data(), body.size(), ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        auto const open =
+            [&](std::uint64_t offset)
+            {
+                file f;
+                system::error_code ec;
+                f.open(path.string().c_str(),
+                    file_mode::scan, ec);
+                BOOST_TEST(! ec.failed());
+                f.seek(offset, ec);
+                BOOST_TEST(! ec.failed());
+                return f;
+            };
+
+        // Content-Length
+        {
+            response res;
+            res.set_content_length(body.size());
+            serializer sr;
+            sr.start_file(res, file_body(open(0)));
+            BOOST_TEST_EQ(
+                read_file(sr, path.string().c_str()),
+                std::string(res.buffer()) + body);
+        }
+
+        // size given, starting at an offset
+        {
+            response res;
+            res.set_content_length(10);
+            serializer sr;
+            sr.start_file(res, file_body(open(4), 10));
+            BOOST_TEST_EQ(
+                read_file(sr, path.string().c_str()),
+                std::string(res.buffer()) +
+                    body.substr(4, 10));
+        }
+
+        // chunked
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start_file(res, file_body(open(0)));
+            auto const s = read_file(
+                sr, path.string().c_str());
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(res.buffer()));
+            sv.remove_prefix(res.buffer().size());
+            check_chunked_body(sv, body);
+        }
+
+        // chunked, empty
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start_file(res, file_body(
+                open(body.size())));
+            BOOST_TEST_EQ(
+                read_file(sr, path.string().c_str()),
+                std::string(res.buffer()) + "0\r\n\r\n");
+        }
+
+        // consume past the output
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start_file(res, file_body(open(0)));
+            auto const n = buffers::buffer_size(
+                sr.prepare().value());
+            BOOST_TEST_THROWS(
+                sr.consume(n + 1),
+                std::invalid_argument);
+            BOOST_TEST_THROWS(
+                sr.consume_file(1),
+                std::invalid_argument);
+        }
+
+        boost::filesystem::remove(path);
+    }
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    void
+    testMapped()
+    {
+        auto const path =
+            boost::filesystem::unique_path();
+        std::string body;
+        for(std::size_t i = 0; i < 10000; ++i)
+            body.push_back('a' + i % 26);
+        {
+            file_posix f;
+            system::error_code ec;
+            f.open(path.string().c_str(),
+                file_mode::write, ec);
+            BOOST_TEST(! ec.failed());
+            f.write(body.data(), body.size(), ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        auto const open =
+            [&](std::uint64_t offset)
+            {
+                file_posix f;
+                system::error_code ec;
+                f.open(path.string().c_str(),
+                    file_mode::scan, ec);
+                BOOST_TEST(! ec.failed());
+                f.seek(offset, ec);
+                BOOST_TEST(! ec.failed());
+                return f;
+            };
+
+        // consume a few bytes at a time
+        auto const read =
+            [](serializer& sr)
+            {
+                std::string s;
+                while(! sr.is_done())
+                {
+                    auto const cbs = sr.prepare().value();
+                    auto const n = (std::min)(
+                        buffers::buffer_size(cbs),
+                        std::size_t(3000));
+                    auto const n0 = s.size();
+                    s.resize(n0 + n);
+                    buffers::buffer_copy(
+                        buffers::mutable_buffer(
+                            &s[n0], n), cbs);
+                    sr.consume(n);
+                }
+                return s;
+            };
+
+        // Content-Length, the header and
+        // body are returned together
+        {
+            response res;
+            res.set_content_length(body.size());
+            serializer sr;
+            sr.start<mmap_body>(res, open(0));
+            auto const cbs = sr.prepare().value();
+            BOOST_TEST_EQ(
+                buffers::buffer_size(cbs),
+                res.buffer().size() + body.size());
+            BOOST_TEST_EQ(read(sr),
+                std::string(res.buffer()) + body);
+        }
+
+        // mapped one page at a time
+        {
+            response res;
+            res.set_content_length(9000);
+            serializer sr;
+            sr.start<mmap_body>(res, open(7),
+                std::uint64_t(9000), std::size_t(1));
+            BOOST_TEST_EQ(read(sr),
+                std::string(res.buffer()) +
+                    body.substr(7, 9000));
+        }
+
+        // chunked
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start<mmap_body>(res, open(0),
+                std::uint64_t(-1), std::size_t(1));
+            auto const s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(res.buffer()));
+            sv.remove_prefix(res.buffer().size());
+            check_chunked_body(sv, body);
+        }
+
+        // chunked, empty
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start<mmap_body>(
+                res, open(body.size()));
+            BOOST_TEST_EQ(read(sr),
+                std::string(res.buffer()) + "0\r\n\r\n");
+        }
+
+        // consume past the output
+        {
+            response res;
+            res.set_chunked(true);
+            serializer sr;
+            sr.start<mmap_body>(res, open(0),
+                std::uint64_t(-1), std::size_t(1));
+            auto const n = buffers::buffer_size(
+                sr.prepare().value());
+            BOOST_TEST_THROWS(
+                sr.consume(n + 1),
+                std::invalid_argument);
+        }
+
+        boost::filesystem::remove(path);
+    }
+#endif
+
     void
     run()
     {
@@ -789,6 +1554,18 @@ struct serializer_test
         testOutput();
         testExpect100Continue();
         testStreamErrors();
+        testStreamCoalesce();
+        testStreamTrailers();
+        testFile();
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+        testMapped();
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_ZLIB
+        testEncoding();
+#endif
+#ifdef BOOST_HTTP_PROTO_HAS_BROTLI
+        testBrotli();
+#endif
     }
 };
 
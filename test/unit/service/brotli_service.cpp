@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/brotli_service.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_BROTLI
+
+#include <boost/http_proto/context.hpp>
+#include <string>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct brotli_service_test
+{
+    void
+    run()
+    {
+        context ctx;
+
+        brotli::decoder_service::config cfg0;
+        cfg0.install(ctx);
+
+        brotli::encoder_service::config cfg1;
+        cfg1.install(ctx);
+
+        auto const& dsvc = ctx.get_service<
+            brotli::decoder_service>();
+        auto const& esvc = ctx.get_service<
+            brotli::encoder_service>();
+
+        // round trip
+        {
+            std::string const s(
+                "Hello, world! Hello, world!");
+            char buf0[256];
+            char buf1[256];
+
+            detail::workspace ws(
+                esvc.space_needed() +
+                dsvc.space_needed());
+
+            auto& enc = esvc.make_filter(ws);
+            auto r0 = enc.process(
+                buffers::mutable_buffer(
+                    buf0, sizeof(buf0)),
+                buffers::const_buffer(
+                    s.data(), s.size()),
+                false);
+            BOOST_TEST(! r0.ec.failed());
+            BOOST_TEST(r0.finished);
+            BOOST_TEST_EQ(r0.in_bytes, s.size());
+
+            auto& dec = dsvc.make_filter(ws);
+            auto r1 = dec.process(
+                buffers::mutable_buffer(
+                    buf1, sizeof(buf1)),
+                buffers::const_buffer(
+                    buf0, r0.out_bytes),
+                false);
+            BOOST_TEST(! r1.ec.failed());
+            BOOST_TEST(r1.finished);
+            BOOST_TEST_EQ(
+                std::string(buf1, r1.out_bytes), s);
+        }
+
+        // invalid stream
+        {
+            char const bad[] = "\xff\xff\xff\xff";
+            char buf[64];
+            detail::workspace ws(
+                dsvc.space_needed());
+            auto& dec = dsvc.make_filter(ws);
+            auto r = dec.process(
+                buffers::mutable_buffer(
+                    buf, sizeof(buf)),
+                buffers::const_buffer(
+                    bad, sizeof(bad) - 1),
+                false);
+            BOOST_TEST(r.ec.failed());
+        }
+
+        // bad config
+        {
+            context ctx1;
+            brotli::encoder_service::config cfg;
+            cfg.quality = 12;
+            BOOST_TEST_THROWS(cfg.install(ctx1),
+                std::invalid_argument);
+
+            // no memory bound
+            cfg.quality = 10;
+            BOOST_TEST_THROWS(cfg.install(ctx1),
+                std::invalid_argument);
+
+            cfg.quality = 5;
+            cfg.window_bits = 25;
+            BOOST_TEST_THROWS(cfg.install(ctx1),
+                std::invalid_argument);
+        }
+        {
+            context ctx1;
+            brotli::decoder_service::config cfg;
+            cfg.max_window_bits = 9;
+            BOOST_TEST_THROWS(cfg.install(ctx1),
+                std::invalid_argument);
+        }
+    }
+};
+
+TEST_SUITE(
+    brotli_service_test,
+    "boost.http_proto.brotli_service");
+
+} // http_proto
+} // boost
+
+#endif
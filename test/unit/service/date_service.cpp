@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/date_service.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_template.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct date_service_test
+{
+    static
+    std::string
+    fmt(std::int64_t t)
+    {
+        return std::string(
+            date_service::format(t).str());
+    }
+
+    void
+    testFormat()
+    {
+        BOOST_TEST_EQ(fmt(784111777),
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+        BOOST_TEST_EQ(fmt(0),
+            "Thu, 01 Jan 1970 00:00:00 GMT");
+        BOOST_TEST_EQ(fmt(-1),
+            "Wed, 31 Dec 1969 23:59:59 GMT");
+        BOOST_TEST_EQ(fmt(951782400),
+            "Tue, 29 Feb 2000 00:00:00 GMT");
+        BOOST_TEST_EQ(fmt(4107542399),
+            "Sun, 28 Feb 2100 23:59:59 GMT");
+        BOOST_TEST_EQ(fmt(4107542400),
+            "Mon, 01 Mar 2100 00:00:00 GMT");
+        BOOST_TEST_EQ(fmt(253402300799),
+            "Fri, 31 Dec 9999 23:59:59 GMT");
+    }
+
+    void
+    testNow()
+    {
+        context ctx;
+        auto& svc = install_date_service(ctx);
+        BOOST_TEST_EQ(
+            &ctx.get_service<date_service>(), &svc);
+        BOOST_TEST_THROWS(
+            install_date_service(ctx),
+            std::invalid_argument);
+
+        using namespace std::chrono;
+        auto const t0 = duration_cast<seconds>(
+            system_clock::now().time_since_epoch()
+                ).count();
+        auto const s = std::string(svc.now().str());
+        auto const t1 = duration_cast<seconds>(
+            system_clock::now().time_since_epoch()
+                ).count();
+        BOOST_TEST(s == fmt(t0) || s == fmt(t1));
+
+        // cached
+        auto const s1 = std::string(svc.now().str());
+        BOOST_TEST(s1 == s || s1 == fmt(t1) ||
+            s1 == fmt(t1 + 1));
+
+        // as a field value
+        response res;
+        res.set(field::date, svc.now());
+        BOOST_TEST_EQ(res.value_or(
+            field::date, "").size(), 29u);
+
+        response_template tpl(res);
+        tpl.set(field::date, svc.now());
+        BOOST_TEST_EQ(response_view(tpl).value_or(
+            field::date, "").size(), 29u);
+    }
+
+    void
+    run()
+    {
+        testFormat();
+        testNow();
+    }
+};
+
+TEST_SUITE(
+    date_service_test,
+    "boost.http_proto.date_service");
+
+} // http_proto
+} // boost
@@ -28,6 +28,12 @@ struct zlib_service_test
         
         zlib::deflate_decoder_service::config cfg;
         cfg.install(ctx);
+
+        zlib::deflate_encoder_service::config cfg1;
+        cfg1.install(ctx);
+        BOOST_TEST_GT(ctx.get_service<
+            zlib::deflate_encoder_service>(
+                ).space_needed(), 0u);
     }
 };
 
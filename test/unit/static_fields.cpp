@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_fields.hpp>
+
+#include <boost/http_proto/fields.hpp>
+#include <functional>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct static_fields_test
+{
+    template<class T>
+    static
+    bool
+    is_inline(T const& t)
+    {
+        auto const p = t.buffer().data();
+        auto const first =
+            reinterpret_cast<char const*>(&t);
+        std::less<char const*> lt;
+        return ! lt(p, first) &&
+            lt(p, first + sizeof(t));
+    }
+
+    void
+    testSpecial()
+    {
+        // static_fields()
+        {
+            static_fields<128> f;
+            BOOST_TEST(is_inline(f));
+            BOOST_TEST_EQ(f.buffer(), "\r\n");
+            BOOST_TEST_EQ(f.size(), 0u);
+        }
+
+        // static_fields(static_fields const&)
+        {
+            static_fields<128> f0;
+            f0.set(field::accept, "text/html");
+            static_fields<128> f1(f0);
+            BOOST_TEST(is_inline(f1));
+            BOOST_TEST_EQ(f1.buffer(), f0.buffer());
+            BOOST_TEST_EQ(f1.at(field::accept), "text/html");
+        }
+
+        // static_fields(fields_view const&)
+        {
+            fields f0;
+            f0.set(field::accept, "text/html");
+            static_fields<128> f1(f0);
+            BOOST_TEST(is_inline(f1));
+            BOOST_TEST_EQ(f1.buffer(), f0.buffer());
+        }
+
+        // operator=(fields_view const&)
+        {
+            static_fields<128> f0;
+            f0.set(field::accept, "text/html");
+            f0 = fields();
+            BOOST_TEST(is_inline(f0));
+            BOOST_TEST_EQ(f0.buffer(), "\r\n");
+            f0.set(field::accept, "text/html");
+            BOOST_TEST(is_inline(f0));
+        }
+    }
+
+    void
+    testModifiers()
+    {
+        // spill to the heap and back
+        static_fields<128> f;
+        f.set(field::accept, "text/html");
+        f.set(field::user_agent, std::string(200, 'x'));
+        BOOST_TEST(! is_inline(f));
+        BOOST_TEST_EQ(f.at(field::accept), "text/html");
+        f.shrink_to_fit();
+        BOOST_TEST(! is_inline(f));
+        f.erase(field::user_agent);
+        f.shrink_to_fit();
+        BOOST_TEST(is_inline(f));
+        BOOST_TEST_EQ(f.buffer(),
+            "Accept: text/html\r\n"
+            "\r\n");
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testModifiers();
+    }
+};
+
+TEST_SUITE(
+    static_fields_test,
+    "boost.http_proto.static_fields");
+
+} // http_proto
+} // boost
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_request.hpp>
+
+#include <boost/http_proto/request.hpp>
+#include <functional>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct static_request_test
+{
+    template<class T>
+    static
+    bool
+    is_inline(T const& t)
+    {
+        auto const p = t.buffer().data();
+        auto const first =
+            reinterpret_cast<char const*>(&t);
+        std::less<char const*> lt;
+        return ! lt(p, first) &&
+            lt(p, first + sizeof(t));
+    }
+
+    void
+    testSpecial()
+    {
+        // static_request()
+        {
+            static_request<256> req;
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+            BOOST_TEST_EQ(req.capacity_in_bytes(), 256u);
+        }
+
+        // static_request(static_request const&)
+        {
+            static_request<256> r0;
+            r0.set_start_line(
+                method::post, "/x", version::http_1_0);
+            r0.set(field::host, "example.com");
+            static_request<256> r1(r0);
+            BOOST_TEST(is_inline(r1));
+            BOOST_TEST_EQ(r1.buffer(), r0.buffer());
+            BOOST_TEST_EQ(r1.method(), method::post);
+            BOOST_TEST_EQ(r1.target(), "/x");
+            BOOST_TEST_EQ(r1.version(), version::http_1_0);
+        }
+
+        // static_request(request_view const&)
+        {
+            request r0;
+            r0.set(field::host, "example.com");
+            static_request<256> r1(r0);
+            BOOST_TEST(is_inline(r1));
+            BOOST_TEST_EQ(r1.buffer(), r0.buffer());
+            BOOST_TEST(r1.exists(field::host));
+        }
+
+        // operator=(request_view const&)
+        {
+            static_request<256> r0;
+            r0.set(field::host, "example.com");
+            r0 = request();
+            BOOST_TEST(is_inline(r0));
+            BOOST_TEST_EQ(r0.buffer(),
+                "GET / HTTP/1.1\r\n\r\n");
+            r0.set(field::host, "example.com");
+            BOOST_TEST(is_inline(r0));
+        }
+    }
+
+    void
+    testModifiers()
+    {
+        // the start-line grows in place
+        {
+            static_request<512> req;
+            req.set(field::host, "example.com");
+            req.set_target("/" + std::string(200, 'a'));
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.target(),
+                "/" + std::string(200, 'a'));
+            BOOST_TEST_EQ(req.at(field::host), "example.com");
+            req.set_target(req.target().substr(0, 10));
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.target(), "/aaaaaaaaa");
+            req.set_method("MKCALENDAR");
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.buffer(),
+                "MKCALENDAR /aaaaaaaaa HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+
+        // spill to the heap and back
+        {
+            static_request<128> req;
+            req.set(field::host, "example.com");
+            req.set(field::user_agent, std::string(200, 'x'));
+            BOOST_TEST(! is_inline(req));
+            BOOST_TEST_EQ(req.at(field::host), "example.com");
+            req.erase(field::user_agent);
+            req.shrink_to_fit();
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.buffer(),
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "\r\n");
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testModifiers();
+    }
+};
+
+TEST_SUITE(
+    static_request_test,
+    "boost.http_proto.static_request");
+
+} // http_proto
+} // boost
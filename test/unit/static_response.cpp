@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_response.hpp>
+
+#include <boost/http_proto/response.hpp>
+#include <functional>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct static_response_test
+{
+    template<class T>
+    static
+    bool
+    is_inline(T const& t)
+    {
+        auto const p = t.buffer().data();
+        auto const first =
+            reinterpret_cast<char const*>(&t);
+        std::less<char const*> lt;
+        return ! lt(p, first) &&
+            lt(p, first + sizeof(t));
+    }
+
+    void
+    testSpecial()
+    {
+        // static_response()
+        {
+            static_response<256> res;
+            BOOST_TEST(is_inline(res));
+            BOOST_TEST_EQ(res.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+        }
+
+        // static_response(static_response const&)
+        {
+            static_response<256> r0;
+            r0.set_start_line(status::not_found);
+            r0.set_content_length(0);
+            static_response<256> r1(r0);
+            BOOST_TEST(is_inline(r1));
+            BOOST_TEST_EQ(r1.buffer(), r0.buffer());
+            BOOST_TEST_EQ(r1.status(), status::not_found);
+            BOOST_TEST_EQ(r1.payload_size(), 0u);
+        }
+
+        // static_response(response_view const&)
+        {
+            response r0(status::no_content);
+            static_response<256> r1(r0);
+            BOOST_TEST(is_inline(r1));
+            BOOST_TEST_EQ(r1.buffer(), r0.buffer());
+            BOOST_TEST_EQ(r1.status_int(), 204);
+        }
+
+        // operator=(response_view const&)
+        {
+            static_response<256> r0;
+            r0.set(field::server, "boost");
+            r0 = response();
+            BOOST_TEST(is_inline(r0));
+            BOOST_TEST_EQ(r0.buffer(),
+                "HTTP/1.1 200 OK\r\n\r\n");
+        }
+    }
+
+    void
+    testModifiers()
+    {
+        // a typical response stays inline
+        {
+            static_response<512> res;
+            res.set_start_line(status::ok);
+            res.append({
+                { field::server, "boost" },
+                { field::content_type, "text/html" },
+                { field::content_length, "4096" } });
+            res.set_keep_alive(false);
+            res.set_start_line(
+                status::non_authoritative_information);
+            BOOST_TEST(is_inline(res));
+            BOOST_TEST_EQ(res.buffer(),
+                "HTTP/1.1 203 Non-Authoritative Information\r\n"
+                "Server: boost\r\n"
+                "Content-Type: text/html\r\n"
+                "Content-Length: 4096\r\n"
+                "Connection: close\r\n"
+                "\r\n");
+        }
+
+        // spill to the heap and back
+        {
+            static_response<64> res;
+            res.set(field::etag, std::string(100, 'x'));
+            BOOST_TEST(! is_inline(res));
+            res.set(field::etag, "\"1\"");
+            res.shrink_to_fit();
+            BOOST_TEST(is_inline(res));
+            BOOST_TEST_EQ(res.buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "ETag: \"1\"\r\n"
+                "\r\n");
+        }
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testModifiers();
+    }
+};
+
+TEST_SUITE(
+    static_response_test,
+    "boost.http_proto.static_response");
+
+} // http_proto
+} // boost
@@ -17,10 +17,13 @@
 #include <boost/buffers/buffer_size.hpp>
 #include <boost/buffers/make_buffer.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include <boost/container/pmr/global_resource.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
 #include <boost/core/detail/string_view.hpp>
 
 #include "test_suite.hpp"
 
+#include <cstddef>
 #include <iterator>
 #include <string>
 
@@ -50,6 +53,52 @@ test_to_string(Buffers const& bs)
 
 //------------------------------------------------
 
+// memory resource which counts the
+// bytes outstanding, using the heap
+class test_resource
+    : public container::pmr::memory_resource
+{
+    void*
+    do_allocate(
+        std::size_t n,
+        std::size_t align) override
+    {
+        auto p = container::pmr::
+            new_delete_resource()->allocate(
+                n, align);
+        bytes += n;
+        ++allocs;
+        return p;
+    }
+
+    void
+    do_deallocate(
+        void* p,
+        std::size_t n,
+        std::size_t align) override
+    {
+        BOOST_TEST_GE(bytes, n);
+        bytes -= n;
+        container::pmr::
+            new_delete_resource()->deallocate(
+                p, n, align);
+    }
+
+    bool
+    do_is_equal(
+        memory_resource const& mr)
+            const noexcept override
+    {
+        return this == &mr;
+    }
+
+public:
+    std::size_t bytes = 0;
+    std::size_t allocs = 0;
+};
+
+//------------------------------------------------
+
 // Test that fields equals HTTP string
 void
 test_fields(
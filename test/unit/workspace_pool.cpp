@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/workspace_pool.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/string_body.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct workspace_pool_test
+{
+    static
+    void
+    feed(
+        request_parser& pr,
+        core::string_view s)
+    {
+        auto const b = *pr.prepare().begin();
+        BOOST_TEST_GE(b.size(), s.size());
+        std::memcpy(b.data(), s.data(), s.size());
+        pr.commit(s.size());
+    }
+
+    static
+    std::string
+    read(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto const cbs = sr.prepare().value();
+            auto const n =
+                buffers::buffer_size(cbs);
+            auto const n0 = s.size();
+            s.resize(n0 + n);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &s[n0], n), cbs);
+            sr.consume(n);
+        }
+        return s;
+    }
+
+    void
+    testParser()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        install_workspace_pool(ctx);
+
+        request_parser pr0(ctx);
+        request_parser pr1(ctx);
+
+        // one message at a time
+        for(int i = 0; i < 3; ++i)
+        {
+            for(auto* pr : { &pr0, &pr1 })
+            {
+                pr->reset();
+                pr->start();
+                feed(*pr,
+                    "GET / HTTP/1.1\r\n"
+                    "Content-Length: 3\r\n"
+                    "\r\n"
+                    "abc");
+                system::error_code ec;
+                pr->parse(ec);
+                BOOST_TEST(! ec.failed());
+                BOOST_TEST(pr->is_complete());
+                BOOST_TEST_EQ(pr->body(), "abc");
+            }
+        }
+
+        // parse before prepare
+        {
+            pr0.reset();
+            pr0.start();
+            system::error_code ec;
+            pr0.parse(ec);
+            BOOST_TEST(
+                ec == condition::need_more_input);
+            feed(pr0,
+                "GET / HTTP/1.1\r\n\r\n");
+            pr0.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr0.got_header());
+        }
+
+        // pipelined data is kept
+        {
+            pr0.reset();
+            pr0.start();
+            feed(pr0,
+                "GET /1 HTTP/1.1\r\n\r\n"
+                "GET /2 HTTP/1.1\r\n\r\n");
+            system::error_code ec;
+            pr0.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(
+                pr0.get().target_text(), "/1");
+            pr0.start();
+            pr0.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(
+                pr0.get().target_text(), "/2");
+        }
+    }
+
+    void
+    testSerializer()
+    {
+        context ctx;
+        install_workspace_pool(ctx);
+
+        serializer sr0(ctx);
+        serializer sr1(ctx);
+        for(int i = 0; i < 3; ++i)
+        {
+            for(auto* sr : { &sr0, &sr1 })
+            {
+                response res;
+                res.set_content_length(5);
+                sr->start(res,
+                    string_body("hello"));
+                BOOST_TEST_EQ(read(*sr),
+                    std::string(res.buffer()) +
+                        "hello");
+            }
+        }
+
+        // reset before the message is done
+        {
+            response res;
+            res.set_chunked(true);
+            sr0.start(res,
+                string_body("hello"));
+            sr0.reset();
+            sr0.start(res);
+            BOOST_TEST_EQ(read(sr0),
+                std::string(res.buffer()) +
+                    "0\r\n\r\n");
+        }
+    }
+
+    void
+    run()
+    {
+        testParser();
+        testSerializer();
+
+        // installed twice
+        {
+            context ctx;
+            install_workspace_pool(ctx, 1);
+            BOOST_TEST_THROWS(
+                install_workspace_pool(ctx),
+                std::invalid_argument);
+        }
+    }
+};
+
+TEST_SUITE(
+    workspace_pool_test,
+    "boost.http_proto.workspace_pool");
+
+} // http_proto
+} // boost